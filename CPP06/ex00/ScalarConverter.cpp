@@ -2,12 +2,181 @@
 #include <cmath>
 #include <cctype>
 
+/*
+**	Literal classification: one pass of a finite-state machine over the
+**	characters. Each character is mapped to a class, and the transition
+**	table gives the next state for (state, class). A transition can also
+**	be an error code, which stops the scan. The state the scan ends in
+**	gives the type. Whitespace after a complete number goes to S_TRAILING,
+**	so trailing and inner whitespace get different reasons without looking
+**	ahead. Integers are accumulated on the way, so an out-of-range int is
+**	known (and becomes a double) without another pass. Only an invalid
+**	literal takes a second pass, to pick its reason (see invalidReason).
+*/
+namespace
+{
+	enum State
+	{
+		S_START, S_SIGN, S_INT, S_DOT, S_FRACTION, S_FLOAT,
+		S_N, S_NA, S_NAN, S_NANF, S_I, S_IN, S_INF, S_INFF, S_TRAILING,
+		STATE_COUNT
+	};
+
+	enum CharClass
+	{
+		C_DIGIT, C_SIGN, C_DOT, C_F, C_N, C_A, C_I, C_SPACE, C_OTHER, C_UNPRINTABLE,
+		CLASS_COUNT
+	};
+
+	/* Error codes share the transition table with states, from ERROR_BASE up */
+	enum Error
+	{
+		ERROR_BASE = STATE_COUNT,
+		X_NPR = ERROR_BASE, X_SPC, X_MID, X_SGN, X_POS, X_DOT, X_F, X_DIG, X_CHR, X_FPT
+	};
+
+	const char* const errorReasons[] = {
+		"non-printable character detected.",
+		"invalid format: leading or trailing whitespace",
+		"invalid format: whitespace in literal",
+		"invalid format: multiple signs",
+		"invalid format: sign must come first",
+		"invalid format: multiple decimal points",
+		"invalid float format: 'f' must be at the end",
+		"invalid format: no digits",
+		"invalid characters in literal",
+		"invalid float format: missing decimal point"
+	};
+
+	const unsigned char transitions[STATE_COUNT][CLASS_COUNT] = {
+		/*               DIGIT       SIGN    DOT         F        N      A      I      SPACE       OTHER  UNPRINTABLE */
+		/* START    */ { S_INT,      S_SIGN, S_DOT,      X_CHR,   S_N,   X_CHR, S_I,   X_SPC,      X_CHR, X_NPR },
+		/* SIGN     */ { S_INT,      X_SGN,  S_DOT,      X_CHR,   X_CHR, X_CHR, S_I,   X_MID,      X_CHR, X_NPR },
+		/* INT      */ { S_INT,      X_POS,  S_FRACTION, S_FLOAT, X_CHR, X_CHR, X_CHR, S_TRAILING, X_CHR, X_NPR },
+		/* DOT      */ { S_FRACTION, X_POS,  X_DOT,      X_DIG,   X_CHR, X_CHR, X_CHR, X_MID,      X_CHR, X_NPR },
+		/* FRACTION */ { S_FRACTION, X_POS,  X_DOT,      S_FLOAT, X_CHR, X_CHR, X_CHR, S_TRAILING, X_CHR, X_NPR },
+		/* FLOAT    */ { X_F,        X_F,    X_F,        X_F,     X_F,   X_F,   X_F,   S_TRAILING, X_F,   X_NPR },
+		/* N        */ { X_CHR,      X_CHR,  X_CHR,      X_CHR,   X_CHR, S_NA,  X_CHR, X_MID,      X_CHR, X_NPR },
+		/* NA       */ { X_CHR,      X_CHR,  X_CHR,      X_CHR,   S_NAN, X_CHR, X_CHR, X_MID,      X_CHR, X_NPR },
+		/* NAN      */ { X_CHR,      X_CHR,  X_CHR,      S_NANF,  X_CHR, X_CHR, X_CHR, S_TRAILING, X_CHR, X_NPR },
+		/* NANF     */ { X_F,        X_F,    X_F,        X_F,     X_F,   X_F,   X_F,   S_TRAILING, X_F,   X_NPR },
+		/* I        */ { X_CHR,      X_CHR,  X_CHR,      X_CHR,   S_IN,  X_CHR, X_CHR, X_MID,      X_CHR, X_NPR },
+		/* IN       */ { X_CHR,      X_CHR,  X_CHR,      S_INF,   X_CHR, X_CHR, X_CHR, X_MID,      X_CHR, X_NPR },
+		/* INF      */ { X_F,        X_F,    X_F,        S_INFF,  X_F,   X_F,   X_F,   S_TRAILING, X_F,   X_NPR },
+		/* INFF     */ { X_F,        X_F,    X_F,        X_F,     X_F,   X_F,   X_F,   S_TRAILING, X_F,   X_NPR },
+		/* TRAILING */ { X_MID,      X_MID,  X_MID,      X_MID,   X_MID, X_MID, X_MID, S_TRAILING, X_MID, X_NPR }
+	};
+
+	/* Type of a literal ending in each state; INVALID states end with endErrors */
+	const ScalarConverter::Type endTypes[STATE_COUNT] = {
+		ScalarConverter::INVALID, ScalarConverter::INVALID, ScalarConverter::INT,
+		ScalarConverter::INVALID, ScalarConverter::DOUBLE, ScalarConverter::FLOAT,
+		ScalarConverter::INVALID, ScalarConverter::INVALID, ScalarConverter::DOUBLE,
+		ScalarConverter::FLOAT, ScalarConverter::INVALID, ScalarConverter::INVALID,
+		ScalarConverter::DOUBLE, ScalarConverter::FLOAT, ScalarConverter::INVALID
+	};
+
+	const unsigned char endErrors[STATE_COUNT] = {
+		X_DIG, X_DIG, 0, X_DIG, 0, 0, X_CHR, X_CHR, 0, 0, X_CHR, X_CHR, 0, 0, X_SPC
+	};
+
+	/* Character to class, built once */
+	struct CharClasses
+	{
+		unsigned char	table[256];
+
+		CharClasses()
+		{
+			for (int c = 0; c < 256; c++)
+			{
+				if (std::isdigit(c))
+					table[c] = C_DIGIT;
+				else if (std::isspace(c))
+					table[c] = C_SPACE;
+				else if (std::isprint(c))
+					table[c] = C_OTHER;
+				else
+					table[c] = C_UNPRINTABLE;
+			}
+			table['+'] = C_SIGN;
+			table['-'] = C_SIGN;
+			table['.'] = C_DOT;
+			table['f'] = C_F;
+			table['n'] = C_N;
+			table['a'] = C_A;
+			table['i'] = C_I;
+		}
+	};
+
+	const CharClasses	charClasses;
+
+	/* Magnitudes past INT_MAX + 1 stop growing: they are out of range either way */
+	const unsigned long	INT_MAGNITUDE_CAP = 2147483648UL + 1;
+
+	/*
+	**	Reason for a literal the scan rejected with error. The scan stops at
+	**	the first bad character, so this pass looks at the whole literal and
+	**	applies the checks in order of priority: a non-printable character
+	**	anywhere, multiple points, a misplaced 'f' or one with no point,
+	**	multiple signs, whitespace at either end, invalid characters. Only a
+	**	literal none of them describes keeps the reason of the transition.
+	*/
+	const char*	invalidReason(const std::string& literal, unsigned int error)
+	{
+		const size_t	length = literal.length();
+		size_t			points = 0;
+		size_t			signs = 0;
+		size_t			firstF = std::string::npos;
+		bool			other = false;
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			const unsigned char	c = static_cast<unsigned char>(literal[i]);
+
+			switch (charClasses.table[c])
+			{
+				case C_UNPRINTABLE:
+					return errorReasons[X_NPR - ERROR_BASE];
+				case C_DOT:
+					points++;
+					break;
+				case C_SIGN:
+					signs++;
+					break;
+				case C_F:
+					if (firstF == std::string::npos)
+						firstF = i;
+					break;
+				case C_DIGIT:
+				case C_SPACE:
+					break;
+				default:
+					other = true;
+			}
+		}
+		if (points > 1)
+			error = X_DOT;
+		else if (firstF != std::string::npos && firstF != length - 1)
+			error = X_F;
+		else if (firstF != std::string::npos && points == 0)
+			error = X_FPT;
+		else if (signs > 1)
+			error = X_SGN;
+		else if (std::isspace(static_cast<unsigned char>(literal[0]))
+			|| std::isspace(static_cast<unsigned char>(literal[length - 1])))
+			error = X_SPC;
+		else if (other)
+			error = X_CHR;
+		return errorReasons[error - ERROR_BASE];
+	}
+}
+
 /**
  * @brief Converts string literal to scalar types (char, int, float, double) and displays results
  * 
  * @param literal Input string to convert. Valid formats: char ('a'), int (42), 
  *                float (42.0f, nanf), double (42.0, nan)
- * @return void Returns early on empty input, pseudo-literals, or after conversion
+ * @return void Returns early on empty input, or after conversion or error
  */
 void ScalarConverter::convert(const std::string& literal)
 {
@@ -16,74 +185,62 @@ void ScalarConverter::convert(const std::string& literal)
 		return;
 	}
 
-	// Check for non-printable characters first
-    for (size_t i = 0; i < literal.length(); i++)
-	{
-        if (!std::isprint(literal[i]) && !std::isspace(literal[i]))
-		{
-            std::cerr << "Error: non-printable character detected." << std::endl;
-            return;
-        }
-    }
-
-	// Handle pseudo-literals first
-	if (handlePseudoLiterals(literal))
-		return;
-
-	// Then try to detect and convert the type
 	convertLiteral(literal);
 }
 
 /**
- * @brief Detects and processes pseudo-literals (nan, inf and their variants)
+ * @brief Classifies a literal in a single pass over its characters
  * 
- * @param literal String to check against known pseudo-literals
- * @return true If literal is a pseudo-literal and was handled
- *         false If literal is not a pseudo-literal
+ * @param literal Non-empty string to classify
+ * @return Literal Its type (CHAR, INT, FLOAT, DOUBLE, or INVALID with the
+ *         reason in error) and the length of its numeric part.
+ *         Pseudo-literals (nan, +inf, -inff, ...) are FLOAT or DOUBLE, and an
+ *         integer outside the int range is a DOUBLE
  */
-bool ScalarConverter::handlePseudoLiterals(const std::string& literal)
+ScalarConverter::Literal ScalarConverter::classify(const std::string& literal)
 {
-	const std::string pseudos[] = {
-		"nan", "nanf", "+inf", "-inf", "+inff", "-inff", "inf", "inff"
-	};
+	Literal				result = { INVALID, NULL, 0 };
+	const size_t		length = literal.length();
+	const unsigned char	first = static_cast<unsigned char>(literal[0]);
 
-	for (size_t i = 0; i < sizeof(pseudos) / sizeof(pseudos[0]); ++i)
+	if (length == 1 && std::isprint(first) && !std::isdigit(first))
 	{
-		if (literal == pseudos[i]) {
-			printPseudoLiteral(literal);
-			return true;
-		}
+		result.type = CHAR;
+		return result;
 	}
-	return false;
-}
 
-/**
- * @brief Displays scalar conversions for pseudo-literals (nan/inf variants)
- * 
- * @param literal The pseudo-literal to format and display ("nan", "inf", etc.)
- * @return void Prints char/int as impossible, formats float/double appropriately
- */
-void ScalarConverter::printPseudoLiteral(const std::string& literal)
-{
-	// char and int are impossible for all pseudo-literals
-	std::cout << "char: impossible" << std::endl;
-	std::cout << "int: impossible" << std::endl;
+	unsigned int	state = S_START;
+	unsigned long	magnitude = 0;
 
-	// Handle nan cases
-	if (literal == "nan" || literal == "nanf") {
-		std::cout << "float: nanf" << std::endl;
-		std::cout << "double: nan" << std::endl;
-		return;
+	for (size_t i = 0; i < length; ++i)
+	{
+		const unsigned char	c = static_cast<unsigned char>(literal[i]);
+		const unsigned int	charClass = charClasses.table[c];
+
+		state = transitions[state][charClass];
+		if (state >= ERROR_BASE)
+		{
+			result.error = invalidReason(literal, state);
+			return result;
+		}
+		if (charClass == C_DIGIT && magnitude < INT_MAGNITUDE_CAP)
+			magnitude = magnitude * 10 + (c - '0');
 	}
 
-	// Handle infinity cases
-	bool isNegative = (literal[0] == '-');
-	std::cout << "float: " << (isNegative ? "-" : "+") << "inff" << std::endl;
-	std::cout << "double: " << (isNegative ? "-" : "+") << "inf" << std::endl;
+	result.type = endTypes[state];
+	if (result.type == INVALID)
+	{
+		result.error = invalidReason(literal, endErrors[state]);
+		return result;
+	}
+	result.numberLength = (result.type == FLOAT) ? length - 1 : length;
+	if (result.type == INT && magnitude > (first == '-' ? 2147483648UL : 2147483647UL))
+		result.type = DOUBLE;
+	return result;
 }
 
 /**
- * @brief Converts detected literal type to double and prints all scalar conversions
+ * @brief Converts classified literal to double and prints all scalar conversions
  * 
  * @param literal String to convert based on its detected type
  * @return void Returns on error or after printing successful conversions
@@ -92,17 +249,16 @@ void ScalarConverter::printPseudoLiteral(const std::string& literal)
 void ScalarConverter::convertLiteral(const std::string& literal)
 {
 	double value = 0.0;
-	Type type = detectType(literal);
+	Literal classified = classify(literal);
 
-    if (type == INVALID)
+	if (classified.type == INVALID)
 	{
-        std::string reason = getInvalidTypeReason(literal);
-        std::cerr << "Error: " << reason << std::endl;
-        return ;
-    }
+		std::cerr << "Error: " << classified.error << std::endl;
+		return ;
+	}
 
 	try {
-		switch (type) {
+		switch (classified.type) {
 			case CHAR:
 				value = static_cast<double>(literal[0]);
 				break;
@@ -126,159 +282,6 @@ void ScalarConverter::convertLiteral(const std::string& literal)
 	}
 }
 
-/**
- * @brief Determines specific reason why a literal is invalid
- * 
- * @param literal String to analyze for format errors
- * @return std::string Detailed error message explaining why the literal is invalid
- */
-std::string ScalarConverter::getInvalidTypeReason(const std::string& literal)
-{
-    // Count decimal points
-    int decimalPoints = 0;
-    for (size_t i = 0; i < literal.length(); i++)
-	{
-        if (literal[i] == '.')
-            decimalPoints++;
-    }
-
-    // Check for specific format issues
-    if (decimalPoints > 1)
-        return "invalid format: multiple decimal points";
-    
-    if (literal.find('f') != std::string::npos)
-	{
-        if (literal.find('f') != literal.length() - 1)
-            return "invalid float format: 'f' must be at the end";
-        if (decimalPoints == 0)
-            return "invalid float format: missing decimal point";
-    }
-
-    if (literal.find_first_of("+-") != std::string::npos 
-        && literal.find_first_of("+-") != literal.find_last_of("+-"))
-        return "invalid format: multiple signs";
-
-    if (std::isspace(literal[0]) || std::isspace(literal[literal.length() - 1]))
-        return "invalid format: leading or trailing whitespace";
-
-    for (size_t i = 0; i < literal.length(); i++)
-	{
-        if (!std::isdigit(literal[i]) && 
-            literal[i] != '.' && 
-            literal[i] != 'f' && 
-            literal[i] != '+' && 
-            literal[i] != '-' &&
-            !std::isspace(literal[i]))
-            return "invalid characters in literal";
-    }
-
-    return "invalid literal type";
-}
-
-/**
- * @brief Determines scalar type of input string
- * 
- * @param literal String to analyze for type detection
- * @return Type CHAR, INT, FLOAT, DOUBLE based on format match
- *         INVALID if no valid type detected
- */
-ScalarConverter::Type ScalarConverter::detectType(const std::string& literal)
-{
-	if (isChar(literal))
-		return CHAR;
-	if (isInt(literal))
-		return INT;
-	if (isFloat(literal))
-		return FLOAT;
-	if (isDouble(literal))
-		return DOUBLE;
-	return INVALID;
-}
-
-bool ScalarConverter::isChar(const std::string& literal)
-{
-	return (literal.length() == 1 && 
-			std::isprint(literal[0]) && 
-			!std::isdigit(literal[0]));
-}
-
-bool ScalarConverter::isInt(const std::string& literal)
-{
-	if (literal.empty()) 
-		return false;
-
-	size_t start = 0;
-	if (literal[0] == '+' || literal[0] == '-')
-		start = 1;
-
-	if (start == literal.length())
-		return false;
-
-	for (size_t i = start; i < literal.length(); ++i) {
-		if (!std::isdigit(literal[i]))
-			return false;
-	}
-
-	try {
-		long num = std::strtol(literal.c_str(), NULL, 10);
-		return (num >= std::numeric_limits<int>::min() && 
-				num <= std::numeric_limits<int>::max());
-	}
-	catch (...) {
-		return false;
-	}
-}
-
-bool ScalarConverter::isFloat(const std::string& literal)
-{
-	if (literal.empty() || literal[literal.length() - 1] != 'f')
-		return false;
-
-	std::string withoutF = literal.substr(0, literal.length() - 1);
-	return isValidNumber(withoutF);
-}
-
-bool ScalarConverter::isDouble(const std::string& literal)
-{
-	return isValidNumber(literal);
-}
-
-/** 
-* @brief Validates if string represents a valid numerical format
-* 
-* @param str String to validate for numerical format
-* @return true If string follows number format (optional sign, digits, optional single decimal)
-*         false If empty, multiple decimals, or contains non-numeric characters
-*/
-bool ScalarConverter::isValidNumber(const std::string& str)
-{
-	if (str.empty())
-		return false;
-
-	size_t start = 0;
-	bool hasDecimal = false;
-
-	if (str[0] == '+' || str[0] == '-')
-		start = 1;
-
-	if (start == str.length())
-		return false;
-
-	for (size_t i = start; i < str.length(); ++i)
-	{
-		if (str[i] == '.')
-		{
-			if (hasDecimal)
-				return false;
-			hasDecimal = true;
-		}
-		else if (!std::isdigit(str[i]))
-			return false;
-	}
-
-	return true;
-}
-
 void ScalarConverter::printConversions(double value)
 {
 	printChar(value);
@@ -12,8 +12,27 @@
 class ScalarConverter
 {
 public:
-	/*** static public method ***/
-	static void convert(const std::string& literal);
+	/*** public enum for type identification ***/
+	enum Type
+	{
+		CHAR,
+		INT,
+		FLOAT,
+		DOUBLE,
+		INVALID
+	};
+
+	/*** result of classify ***/
+	struct Literal
+	{
+		Type		type;
+		const char*	error;			// why the literal is INVALID, NULL otherwise
+		size_t		numberLength;	// characters of the numeric part (sign included, 'f' suffix excluded)
+	};
+
+	/*** static public methods ***/
+	static void		convert(const std::string& literal);
+	static Literal	classify(const std::string& literal);
 
 private:
 	/*** private constructor - static class ***/
@@ -25,30 +44,7 @@ private:
 	/*** destructor ***/
 	~ScalarConverter();
 
-	/*** private enum for type identification ***/
-	enum Type
-	{
-		CHAR,
-		INT,
-		FLOAT,
-		DOUBLE,
-		INVALID
-	};
-
 	/*** private helper methods ***/
-	/* type detection and validation */
-	static Type detectType(const std::string& literal);
-	static std::string getInvalidTypeReason(const std::string& literal);
-	static bool isChar(const std::string& literal);
-	static bool isInt(const std::string& literal);
-	static bool isFloat(const std::string& literal);
-	static bool isDouble(const std::string& literal);
-	static bool isValidNumber(const std::string& str);
-
-	/* pseudo-literal handling */
-	static bool handlePseudoLiterals(const std::string& literal);
-	static void printPseudoLiteral(const std::string& literal);
-
 	/* conversion and printing */
 	static void convertLiteral(const std::string& literal);
 	static void printConversions(double value);
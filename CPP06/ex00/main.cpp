@@ -1,6 +1,10 @@
 #include "ScalarConverter.h"
 #include <iostream>
 #include <iomanip>
+#include <vector>
+#include <limits>
+#include <cctype>
+#include <ctime>
 
 void printTestHeader(const std::string& testName) {
     std::cout << "\n=== Testing " << testName << " ===" << std::endl;
@@ -12,6 +16,134 @@ void runTest(const std::string& literal) {
     ScalarConverter::convert(literal);
 }
 
+/*
+** The previous classification (one scan per candidate type, pseudo-literals
+** compared against 8 strings, more scans for the error reason), kept as the
+** benchmark baseline. Returns the type, or INVALID with the reason in reason.
+*/
+static bool legacyIsValidNumber(const std::string& str) {
+    if (str.empty())
+        return false;
+    size_t start = (str[0] == '+' || str[0] == '-') ? 1 : 0;
+    bool hasDecimal = false;
+    if (start == str.length())
+        return false;
+    for (size_t i = start; i < str.length(); ++i) {
+        if (str[i] == '.') {
+            if (hasDecimal)
+                return false;
+            hasDecimal = true;
+        }
+        else if (!std::isdigit(str[i]))
+            return false;
+    }
+    return true;
+}
+
+static bool legacyIsInt(const std::string& literal) {
+    size_t start = (literal[0] == '+' || literal[0] == '-') ? 1 : 0;
+    if (start == literal.length())
+        return false;
+    for (size_t i = start; i < literal.length(); ++i)
+        if (!std::isdigit(literal[i]))
+            return false;
+    long num = std::strtol(literal.c_str(), NULL, 10);
+    return (num >= std::numeric_limits<int>::min() && num <= std::numeric_limits<int>::max());
+}
+
+static std::string legacyReason(const std::string& literal) {
+    int decimalPoints = 0;
+    for (size_t i = 0; i < literal.length(); i++)
+        if (literal[i] == '.')
+            decimalPoints++;
+    if (decimalPoints > 1)
+        return "invalid format: multiple decimal points";
+    if (literal.find('f') != std::string::npos) {
+        if (literal.find('f') != literal.length() - 1)
+            return "invalid float format: 'f' must be at the end";
+        if (decimalPoints == 0)
+            return "invalid float format: missing decimal point";
+    }
+    if (literal.find_first_of("+-") != std::string::npos
+        && literal.find_first_of("+-") != literal.find_last_of("+-"))
+        return "invalid format: multiple signs";
+    if (std::isspace(literal[0]) || std::isspace(literal[literal.length() - 1]))
+        return "invalid format: leading or trailing whitespace";
+    for (size_t i = 0; i < literal.length(); i++)
+        if (!std::isdigit(literal[i]) && literal[i] != '.' && literal[i] != 'f'
+            && literal[i] != '+' && literal[i] != '-' && !std::isspace(literal[i]))
+            return "invalid characters in literal";
+    return "invalid literal type";
+}
+
+static ScalarConverter::Type legacyClassify(const std::string& literal, std::string& reason) {
+    const std::string pseudos[] = { "nan", "nanf", "+inf", "-inf", "+inff", "-inff", "inf", "inff" };
+
+    for (size_t i = 0; i < literal.length(); i++)
+        if (!std::isprint(literal[i]) && !std::isspace(literal[i])) {
+            reason = "non-printable character detected.";
+            return ScalarConverter::INVALID;
+        }
+    for (size_t i = 0; i < sizeof(pseudos) / sizeof(pseudos[0]); ++i)
+        if (literal == pseudos[i])
+            return (literal == "nanf" || literal.find("inff") != std::string::npos)
+                ? ScalarConverter::FLOAT : ScalarConverter::DOUBLE;
+    if (literal.length() == 1 && std::isprint(literal[0]) && !std::isdigit(literal[0]))
+        return ScalarConverter::CHAR;
+    if (legacyIsInt(literal))
+        return ScalarConverter::INT;
+    if (literal[literal.length() - 1] == 'f' && legacyIsValidNumber(literal.substr(0, literal.length() - 1)))
+        return ScalarConverter::FLOAT;
+    if (legacyIsValidNumber(literal))
+        return ScalarConverter::DOUBLE;
+    reason = legacyReason(literal);
+    return ScalarConverter::INVALID;
+}
+
+static double nowMs() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/*
+** Classifies count literals cycled from a mix of valid and invalid ones,
+** with the legacy functions and with ScalarConverter::classify; the
+** per-type counts must agree (and keep the loops from being optimized away)
+*/
+static void benchmarkClassify(size_t count) {
+    const char* mix[] = {
+        "a", "42", "-2147483648", "2147483648", "42.42f", "-0.5f", "3.14159265358979",
+        ".0", "nan", "-inff", "+inf", "42f", "abc", "42.42.42", "42.42ff", "+-42",
+        "   42", "42   ", "infinff", "123456789012345678901234567890.5"
+    };
+    const size_t mixSize = sizeof(mix) / sizeof(mix[0]);
+    std::vector<std::string> literals;
+    size_t legacyCounts[5] = {0, 0, 0, 0, 0};
+    size_t counts[5] = {0, 0, 0, 0, 0};
+    std::string reason;
+
+    for (size_t i = 0; i < count; i++)
+        literals.push_back(mix[i % mixSize]);
+
+    double start = nowMs();
+    for (size_t i = 0; i < count; i++)
+        legacyCounts[legacyClassify(literals[i], reason)]++;
+    double legacyMs = nowMs() - start;
+    start = nowMs();
+    for (size_t i = 0; i < count; i++)
+        counts[ScalarConverter::classify(literals[i]).type]++;
+    double fsmMs = nowMs() - start;
+
+    bool same = true;
+    for (int t = 0; t < 5; t++)
+        same = same && (legacyCounts[t] == counts[t]);
+    std::cout << count << " literals: legacy " << legacyMs << " ms, state machine " << fsmMs
+              << " ms (" << legacyMs / fsmMs << "x), " << counts[ScalarConverter::INVALID]
+              << " invalid, counts " << (same ? "match" : "DIFFER") << std::endl;
+}
+
 int main() {
     // Test char literals
     printTestHeader("Char Literals");
@@ -99,5 +231,23 @@ int main() {
     runTest("$");   // special character
     runTest("#");   // special character
 
+    // Classification alone
+    printTestHeader("Classification");
+    const char* classified[] = { "+42.5f", "-inff", "2147483648", "4 2", "+." };
+    const char* typeNames[] = { "char", "int", "float", "double", "invalid" };
+    for (size_t i = 0; i < sizeof(classified) / sizeof(classified[0]); i++) {
+        ScalarConverter::Literal literal = ScalarConverter::classify(classified[i]);
+        std::cout << "\"" << classified[i] << "\": " << typeNames[literal.type];
+        if (literal.type == ScalarConverter::INVALID)
+            std::cout << " (" << literal.error << ")";
+        else
+            std::cout << ", numeric part \"" << std::string(classified[i]).substr(0, literal.numberLength) << "\"";
+        std::cout << std::endl;
+    }
+
+    // Benchmark
+    printTestHeader("Benchmark");
+    benchmarkClassify(4000000);
+
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "whatever.h"
 #include <iostream>
 #include <string>
+#include <vector>
+#include <ctime>
 
 /*
 ** Overloading the '<', '>' and '==' operators is essential
@@ -22,6 +24,15 @@ struct Point
 	}
 };
 
+/* Trivially copyable, but no default constructor: cannot fill a local array */
+struct Weight
+{
+	int grams;
+	explicit Weight( int g ) : grams(g) {}
+	bool operator<( const Weight& other ) const { return grams < other.grams; }
+	bool operator>( const Weight& other ) const { return grams > other.grams; }
+};
+
 /* Overload the '<<' operator for Point */
 std::ostream& operator<<( std::ostream& os, const Point& p )
 {
@@ -29,6 +40,102 @@ std::ostream& operator<<( std::ostream& os, const Point& p )
 	return os;
 }
 
+/*
+**	The previous implementations (default construction + three assignments,
+**	an extra '==' before '<'), kept as the benchmark baseline
+*/
+template <typename T>
+void	legacySwap(T& a, T& b)
+{
+	T	temp;
+
+	temp = b;
+	b = a;
+	a = temp;
+}
+
+template <typename T>
+const T&	legacyMin(const T& a, const T& b)
+{
+	if (a == b)
+		return b;
+	return ((a < b) ? a : b);
+}
+
+static double	nowMs(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void	printRow(const char* operation, double legacyMs, double newMs)
+{
+	std::cout << "  " << operation << ": legacy " << legacyMs << " ms, now " << newMs
+		<< " ms (" << legacyMs / newMs << "x)" << std::endl;
+}
+
+/*
+**	Swaps and elementwise min over two arrays of n elements, repeated:
+**	legacy scalar loops against ::swap / swapElements and minElements.
+**	A checksum of the results is printed so the loops are not optimized away.
+*/
+template <typename T>
+static void	benchmark(const char* name, const T& low, const T& high, unsigned long n, int repeats)
+{
+	std::vector<T>	a(n, low);
+	std::vector<T>	b(n, high);
+	std::vector<T>	out(n);
+	unsigned long	checksum = 0;
+	double			start;
+	double			legacyMs;
+
+	for (unsigned long i = 0; i < n; i += 2)
+		::swap(a[i], b[i]);
+	std::cout << name << ": " << repeats << " x " << n << " elements" << std::endl;
+
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		for (unsigned long i = 0; i < n; i++)
+			legacySwap(a[i], b[i]);
+	legacyMs = nowMs() - start;
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		for (unsigned long i = 0; i < n; i++)
+			::swap(a[i], b[i]);
+	printRow("swap one by one   ", legacyMs, nowMs() - start);
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		swapElements(&a[0], &b[0], n);
+	printRow("swapElements      ", legacyMs, nowMs() - start);
+
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+	{
+		for (unsigned long i = 0; i < n; i++)
+			out[i] = legacyMin(a[i], b[i]);
+		checksum += (out[r % n] == low);
+	}
+	legacyMs = nowMs() - start;
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+	{
+		for (unsigned long i = 0; i < n; i++)
+			out[i] = ::min(a[i], b[i]);
+		checksum += (out[r % n] == low);
+	}
+	printRow("min one by one    ", legacyMs, nowMs() - start);
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+	{
+		minElements(&a[0], &b[0], &out[0], n);
+		checksum += (out[r % n] == low);
+	}
+	printRow("minElements       ", legacyMs, nowMs() - start);
+	std::cout << "  all minimums found: " << (checksum == 3UL * repeats ? "yes" : "no") << std::endl;
+}
+
 
 int main(void)
 {
@@ -99,5 +206,58 @@ int main(void)
 
 	std::cout << "-----------------------------\n";
 
+	/* Swap strategy and equal values */
+	std::cout << "Test with swap strategy and equal values" << std::endl;
+	std::cout << "std::string has a member swap: " << (HasMemberSwap<std::string>::value ? "yes" : "no")
+		<< ", std::vector<int>: " << (HasMemberSwap<std::vector<int> >::value ? "yes" : "no")
+		<< ", Point: " << (HasMemberSwap<Point>::value ? "yes" : "no") << std::endl;
+	std::string longString(1000, 'x');
+	std::string shortString("short");
+	const char* buffer = longString.data();
+	::swap(longString, shortString);
+	std::cout << "after swapping a 1000-char string, it kept its buffer: "
+		<< (shortString.data() == buffer ? "yes" : "no") << std::endl;
+	int e1 = 42;
+	int e2 = 42;
+	std::cout << "equal values: min returns the second: " << (&::min(e1, e2) == &e2 ? "yes" : "no")
+		<< ", max returns the second: " << (&::max(e1, e2) == &e2 ? "yes" : "no") << std::endl;
+
+	std::cout << "-----------------------------\n";
+
+	/* Elementwise versions */
+	std::cout << "Test with arrays" << std::endl;
+	float first[] = {1.0f, 8.0f, 3.0f, 6.0f, 5.0f};
+	float second[] = {2.0f, 7.0f, 4.0f, 5.0f, 5.0f};
+	float lowest[5];
+	minElements(first, second, lowest, 5);
+	maxElements(first, second, first, 5);
+	swapElements(first, lowest, 5);
+	std::cout << "max (in place), then swapped with the min:\nfirst = ";
+	for (int i = 0; i < 5; i++)
+		std::cout << first[i] << " ";
+	std::cout << "\nlowest = ";
+	for (int i = 0; i < 5; i++)
+		std::cout << lowest[i] << " ";
+	std::cout << std::endl;
+
+	std::vector<Weight> light(20, Weight(1));
+	std::vector<Weight> heavy(20, Weight(9));
+	std::vector<Weight> lighter(20, Weight(0));
+	minElements(&light[0], &heavy[0], &lighter[0], 20);
+	maxElements(&light[0], &heavy[0], &light[0], 20);
+	swapElements(&light[0], &lighter[0], 20);
+	std::cout << "Weight (no default constructor), 20 elements: light[19] = " << light[19].grams
+		<< ", lighter[19] = " << lighter[19].grams << std::endl;
+
+	std::cout << "-----------------------------\n";
+
+	/* Benchmarks */
+	std::cout << "Benchmarks" << std::endl;
+	benchmark<int>("int", 1, 2, 16384, 20000);
+	benchmark<float>("float", 1.0f, 2.0f, 16384, 20000);
+	benchmark<std::string>("std::string", std::string(100, 'a'), std::string(100, 'b'), 10000, 200);
+
+	std::cout << "-----------------------------\n";
+
 	return 0;
 }
\ No newline at end of file
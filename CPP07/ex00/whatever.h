@@ -6,6 +6,70 @@
 **	means 0 to the exercise.
 */
 
+/*
+**	Compile-time check: does T have a member `void swap(T&)`?
+**	C++98 has no type traits; the member pointer only fits the Check
+**	template when such a member exists, otherwise overload resolution
+**	falls back to the `...` version (SFINAE), and sizeof tells which one won.
+*/
+template <typename T>
+struct HasMemberSwap
+{
+	typedef char	Yes;
+	typedef char	(&No)[2];
+
+	template <typename U, void (U::*)(U&)>
+	struct Check {};
+
+	template <typename U>
+	static Yes	test(Check<U, &U::swap>*);
+	template <typename U>
+	static No	test(...);
+
+	static const bool	value = sizeof(test<T>(0)) == sizeof(Yes);
+};
+
+/* Compile-time flag: T is copied with memcpy and needs no destructor call (GCC builtins) */
+template <typename T>
+struct IsTriviallyCopyable
+{
+	static const bool	value = __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T);
+};
+
+/*
+**	Compile-time flag: T can be staged in a local array, i.e. copied with
+**	memcpy and default constructed for free. A type without a default
+**	constructor cannot be declared as an array at all.
+*/
+template <typename T>
+struct IsStageable
+{
+	static const bool	value = IsTriviallyCopyable<T>::value && __has_trivial_constructor(T);
+};
+
+/* Tag type selecting the staged (block) or the element-by-element overloads */
+template <bool Staged>
+struct StageTag {};
+
+/* Tag type selecting the member swap or the copy overload */
+template <bool HasSwap>
+struct MemberSwapTag {};
+
+template <typename T>
+void	swapDispatch(T& a, T& b, MemberSwapTag<true>)
+{
+	a.swap(b);
+}
+
+template <typename T>
+void	swapDispatch(T& a, T& b, MemberSwapTag<false>)
+{
+	T	temp(a);
+
+	a = b;
+	b = temp;
+}
+
 /*	
 **	template <typename T>
 **	Template declaration: 
@@ -21,7 +85,7 @@ template <typename T>
 **	------------------------
 **	The following function template allows swapping two variables of the same type `T`.
 **	When the function is called, the actual type (e.g., int, double, etc.) replaces `T`.
-**	This template function can be used for any data type that supports assignment.
+**	This template function can be used for any data type that supports copy and assignment.
 **	For example, swap<int>(a, b) swaps two integers, and swap<double>(x, y) swaps two doubles.
 **
 **	Parameters:
@@ -29,17 +93,16 @@ template <typename T>
 **	- `T& b`: A reference to the second element of type `T`.
 **
 **	How it works:
-**	1. A temporary variable `temp` of type `T` is used to store the value of `b`.
-**	2. The value of `a` is assigned to `b`.
-**	3. The temporary value (`temp`) is assigned to `a`, completing the swap.
+**	- If `T` has a member `void swap(T&)` (std::string, every standard container),
+**	  it is used: it exchanges the internal pointers, no element is copied.
+**	- Otherwise a temporary copy-constructed from `a` holds its value while `b`
+**	  is assigned to `a` and the temporary to `b`: one copy construction and
+**	  two assignments, with no default construction.
+**	(C++98 has no move semantics, so member swap is the cheap path.)
 */
 void	swap(T& a, T& b)
 {
-	T	temp;
-
-	temp = b;
-	b = a;
-	a = temp;
+	swapDispatch(a, b, MemberSwapTag<HasMemberSwap<T>::value>());
 }
 
 /*
@@ -55,8 +118,11 @@ template <typename T>
 **	------------------------
 **	Takes two references of the same type `T` and returns the smaller of the two.
 **	- If both values are equal, returns the second parameter `b`.
-**	- Otherwise, uses the conditional operator to return the smaller of `a` and `b`.
-**	
+**	- A single `<` comparison decides both cases: when `a < b` is false,
+**	  `b` is either smaller or equal, and `b` is the answer either way.
+**	For arithmetic types this compiles to a branchless select (minss/minsd
+**	for floating point).
+**
 **	Parameters:
 **	- T& a: First value to compare.
 **	- T& b: Second value to compare.
@@ -66,8 +132,6 @@ template <typename T>
 */
 const T&	min(const T& a, const T& b)
 {
-	if (a == b)
-		return b;
 	return ((a < b) ? a : b);
 }
 
@@ -77,8 +141,8 @@ template <typename T>
 **	------------------------
 **	Takes two references of the same type `T` and returns the larger of the two.
 **	- If both values are equal, returns the second parameter `b`.
-**	- Otherwise, uses the conditional operator to return the larger of `a` and `b`.
-**	
+**	- A single `>` comparison decides both cases, as in `min`.
+**
 **	Parameters:
 **	- T& a: First value to compare.
 **	- T& b: Second value to compare.
@@ -88,11 +152,145 @@ template <typename T>
 */
 const T&	max(const T& a, const T& b)
 {
-	if (a == b)
-		return b;
 	return ((a > b) ? a : b);
 }
 
+/*
+**	Elementwise versions over arrays: out[i] = min(a[i], b[i]),
+**	out[i] = max(a[i], b[i]) and swap(a[i], b[i]) for i in [0, n).
+**	------------------------
+**	The arrays are processed in blocks of WHATEVER_BLOCK elements: the block
+**	results are computed into a local buffer, then stored. Within a block
+**	there is no dependency between elements and no possible aliasing, so
+**	for arithmetic types the compiler turns each block into a few packed
+**	SIMD instructions (minps, maxps, ...). Because of the local buffer,
+**	`out` may be the same array as `a` or `b` (an in-place min).
+**	Only stageable types (trivially copyable and default constructible, see
+**	IsStageable) go through the buffer: for a std::string the extra copy
+**	costs more than it saves, and a type with no default constructor cannot
+**	fill an array. Other types are processed element by element with ::min,
+**	::max and ::swap (member swap when there is one).
+**
+**	Parameters:
+**	- const T* a, const T* b: The input arrays, `n` elements each.
+**	- T* out: The output array, `n` elements.
+**	- T* a, T* b (swapElements): Arrays exchanged element by element;
+**	  they must be the same array or not overlap.
+*/
+static const unsigned long	WHATEVER_BLOCK = 16;
+
+template <typename T>
+void	minElementsDispatch(const T* a, const T* b, T* out, unsigned long n, StageTag<false>)
+{
+	for (unsigned long i = 0; i < n; i++)
+		out[i] = ::min(a[i], b[i]);
+}
+
+template <typename T>
+void	minElementsDispatch(const T* a, const T* b, T* out, unsigned long n, StageTag<true>)
+{
+	unsigned long	i = 0;
+
+	for (; i + WHATEVER_BLOCK <= n; i += WHATEVER_BLOCK)
+	{
+		T	results[WHATEVER_BLOCK];
+#pragma GCC unroll 16
+		for (unsigned long j = 0; j < WHATEVER_BLOCK; j++)
+			results[j] = ::min(a[i + j], b[i + j]);
+#pragma GCC unroll 16
+		for (unsigned long j = 0; j < WHATEVER_BLOCK; j++)
+			out[i + j] = results[j];
+	}
+	for (const T* tail = a + i; tail != a + n; ++tail)
+		out[tail - a] = ::min(*tail, b[tail - a]);
+}
+
+template <typename T>
+void	minElements(const T* a, const T* b, T* out, unsigned long n)
+{
+	minElementsDispatch(a, b, out, n, StageTag<IsStageable<T>::value>());
+}
+
+template <typename T>
+void	maxElementsDispatch(const T* a, const T* b, T* out, unsigned long n, StageTag<false>)
+{
+	for (unsigned long i = 0; i < n; i++)
+		out[i] = ::max(a[i], b[i]);
+}
+
+template <typename T>
+void	maxElementsDispatch(const T* a, const T* b, T* out, unsigned long n, StageTag<true>)
+{
+	unsigned long	i = 0;
+
+	for (; i + WHATEVER_BLOCK <= n; i += WHATEVER_BLOCK)
+	{
+		T	results[WHATEVER_BLOCK];
+#pragma GCC unroll 16
+		for (unsigned long j = 0; j < WHATEVER_BLOCK; j++)
+			results[j] = ::max(a[i + j], b[i + j]);
+#pragma GCC unroll 16
+		for (unsigned long j = 0; j < WHATEVER_BLOCK; j++)
+			out[i + j] = results[j];
+	}
+	for (const T* tail = a + i; tail != a + n; ++tail)
+		out[tail - a] = ::max(*tail, b[tail - a]);
+}
+
+template <typename T>
+void	maxElements(const T* a, const T* b, T* out, unsigned long n)
+{
+	maxElementsDispatch(a, b, out, n, StageTag<IsStageable<T>::value>());
+}
+
+template <typename T>
+void	swapElementsStaged(T* a, T* b, unsigned long n, StageTag<false>)
+{
+	for (unsigned long i = 0; i < n; i++)
+		::swap(a[i], b[i]);
+}
+
+template <typename T>
+void	swapElementsStaged(T* a, T* b, unsigned long n, StageTag<true>)
+{
+	unsigned long	i = 0;
+
+	for (; i + WHATEVER_BLOCK <= n; i += WHATEVER_BLOCK)
+	{
+		T	fromA[WHATEVER_BLOCK];
+#pragma GCC unroll 16
+		for (unsigned long j = 0; j < WHATEVER_BLOCK; j++)
+			fromA[j] = a[i + j];
+#pragma GCC unroll 16
+		for (unsigned long j = 0; j < WHATEVER_BLOCK; j++)
+			a[i + j] = b[i + j];
+#pragma GCC unroll 16
+		for (unsigned long j = 0; j < WHATEVER_BLOCK; j++)
+			b[i + j] = fromA[j];
+	}
+	for (T* tail = a + i; tail != a + n; ++tail)
+		::swap(*tail, b[tail - a]);
+}
+
+template <typename T>
+void	swapElementsDispatch(T* a, T* b, unsigned long n, MemberSwapTag<true>)
+{
+	for (unsigned long i = 0; i < n; i++)
+		a[i].swap(b[i]);
+}
+
+template <typename T>
+void	swapElementsDispatch(T* a, T* b, unsigned long n, MemberSwapTag<false>)
+{
+	swapElementsStaged(a, b, n, StageTag<IsStageable<T>::value>());
+}
+
+template <typename T>
+void	swapElements(T* a, T* b, unsigned long n)
+{
+	swapElementsDispatch(a, b, n, MemberSwapTag<HasMemberSwap<T>::value>());
+}
+
 /*
 **	This template class allows the creation of generic functions 
 **	that operate on different data types without the need for 
@@ -0,0 +1,77 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include "iter.h"
+
+/*
+**	Two element functions applied one after the other: the building block
+**	of a Pipeline. Both are members, so the composition is a type known at
+**	compile time and a chain of functors inlines into a single loop body.
+*/
+template <typename First, typename Second>
+class FusedStage
+{
+public:
+	FusedStage( First first, Second second ) : _first(first), _second(second) {}
+
+	template <typename T>
+	void	operator()( T& element ) const
+	{
+		_first(element);
+		_second(element);
+	}
+
+
+private:
+	First	_first;
+	Second	_second;
+};
+
+/*
+**	Chain of element functions run in one pass over an array instead of one
+**	iter call (one trip through memory) per function:
+**
+**		pipeline(f).then(g).then(h).run(array, len)
+**
+**	does f, g then h on each element before moving to the next one, and
+**	reduce() additionally folds the results as they are produced. A
+**	Pipeline is itself an element function, so iter and parallelIter accept
+**	it too. Functions are stored by value (function pointers decay), so
+**	functors inline where function pointers may not.
+*/
+template <typename Stage>
+class Pipeline
+{
+public:
+	explicit Pipeline( Stage stage );
+
+	template <typename Next>
+	Pipeline< FusedStage<Stage, Next> >	then( Next next ) const;
+
+	template <typename T>
+	void	operator()( T& element ) const;
+
+	template <typename T>
+	void	run( T* array, const size_t& len ) const;
+
+	/*
+	**	run() plus a fold of the transformed elements into init. The fold
+	**	keeps ITER_BLOCK partial results, so op must be associative and
+	**	commutative (floating-point sums may round differently from a
+	**	left-to-right loop).
+	*/
+	template <typename T, typename Acc, typename Op>
+	Acc		reduce( T* array, const size_t& len, Acc init, const Op& op ) const;
+
+
+private:
+	Stage	_stage;
+};
+
+template <typename Func>
+Pipeline<Func>	pipeline( Func f );
+
+/* Include the implementation file */
+#include "Pipeline.tpp"
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef PIPELINE_TPP
+#define PIPELINE_TPP
+
+#include "Pipeline.hpp"
+
+template <typename Stage>
+Pipeline<Stage>::Pipeline( Stage stage ) : _stage(stage) {}
+
+template <typename Stage>
+template <typename Next>
+Pipeline< FusedStage<Stage, Next> >	Pipeline<Stage>::then( Next next ) const
+{
+	return Pipeline< FusedStage<Stage, Next> >(FusedStage<Stage, Next>(_stage, next));
+}
+
+template <typename Stage>
+template <typename T>
+void	Pipeline<Stage>::operator()( T& element ) const { _stage(element); }
+
+/* Fixed-size blocks, fully unrolled, so a chain of cheap functors compiles to packed instructions */
+template <typename Stage>
+template <typename T>
+void	Pipeline<Stage>::run( T* array, const size_t& len ) const
+{
+	size_t	i = 0;
+
+	for (; i + ITER_BLOCK <= len; i += ITER_BLOCK)
+	{
+		T*	block = array + i;
+#pragma GCC unroll 16
+		for (size_t j = 0; j < ITER_BLOCK; j++)
+			_stage(block[j]);
+	}
+	for (T* tail = array + i; tail != array + len; ++tail)
+		_stage(*tail);
+}
+
+template <typename Stage>
+template <typename T, typename Acc, typename Op>
+Acc	Pipeline<Stage>::reduce( T* array, const size_t& len, Acc init, const Op& op ) const
+{
+	size_t	i = 0;
+
+	if (len >= ITER_BLOCK)
+	{
+		Acc	lanes[ITER_BLOCK];
+
+		for (size_t j = 0; j < ITER_BLOCK; j++)
+		{
+			_stage(array[j]);
+			lanes[j] = array[j];
+		}
+		for (i = ITER_BLOCK; i + ITER_BLOCK <= len; i += ITER_BLOCK)
+		{
+			T*	block = array + i;
+#pragma GCC unroll 16
+			for (size_t j = 0; j < ITER_BLOCK; j++)
+				_stage(block[j]);
+			/* the lanes stay in registers across blocks */
+#pragma GCC unroll 16
+			for (size_t j = 0; j < ITER_BLOCK; j++)
+				lanes[j] = op(lanes[j], block[j]);
+		}
+		for (size_t j = 0; j < ITER_BLOCK; j++)
+			init = op(init, lanes[j]);
+	}
+	for (T* tail = array + i; tail != array + len; ++tail)
+	{
+		_stage(*tail);
+		init = op(init, *tail);
+	}
+	return init;
+}
+
+template <typename Func>
+Pipeline<Func>	pipeline( Func f )
+{
+	return Pipeline<Func>(f);
+}
+
+#endif
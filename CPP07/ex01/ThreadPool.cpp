@@ -0,0 +1,123 @@
+#include "ThreadPool.hpp"
+#include <stdexcept>
+#include <unistd.h>
+
+std::size_t	hardwareThreads( void )
+{
+	long	online = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (online > 0) ? static_cast<std::size_t>(online) : 1;
+}
+
+/*** parameterized constructor ***/
+ThreadPool::ThreadPool( std::size_t threads )
+	: _task(NULL), _chunks(0), _next(0), _failed(false), _busy(0), _generation(0), _stop(false)
+{
+	if (threads == 0)
+		threads = hardwareThreads();
+	pthread_mutex_init(&_mutex, NULL);
+	pthread_cond_init(&_wake, NULL);
+	pthread_cond_init(&_done, NULL);
+	for (std::size_t i = 1; i < threads; i++)
+	{
+		pthread_t	worker;
+
+		if (pthread_create(&worker, NULL, workerMain, this) == 0)
+			_workers.push_back(worker);
+	}
+}
+
+/*** destructor ***/
+ThreadPool::~ThreadPool()
+{
+	pthread_mutex_lock(&_mutex);
+	_stop = true;
+	pthread_cond_broadcast(&_wake);
+	pthread_mutex_unlock(&_mutex);
+	for (std::size_t i = 0; i < _workers.size(); i++)
+		pthread_join(_workers[i], NULL);
+	pthread_cond_destroy(&_done);
+	pthread_cond_destroy(&_wake);
+	pthread_mutex_destroy(&_mutex);
+}
+
+/*** getter ***/
+std::size_t	ThreadPool::size( void ) const { return _workers.size() + 1; }
+
+void	ThreadPool::run( PoolTask& task, std::size_t chunks )
+{
+	if (_workers.empty() || chunks <= 1)
+	{
+		for (std::size_t chunk = 0; chunk < chunks; chunk++)
+			task.run(chunk);
+		return;
+	}
+
+	pthread_mutex_lock(&_mutex);
+	_task = &task;
+	_chunks = chunks;
+	_next = 0;
+	_failed = false;
+	_busy = _workers.size();
+	_generation++;
+	pthread_cond_broadcast(&_wake);
+	pthread_mutex_unlock(&_mutex);
+
+	work();
+
+	pthread_mutex_lock(&_mutex);
+	while (_busy > 0)
+		pthread_cond_wait(&_done, &_mutex);
+	_task = NULL;
+	pthread_mutex_unlock(&_mutex);
+
+	if (_failed)
+		throw std::runtime_error("ThreadPool: a chunk threw an exception");
+}
+
+void*	ThreadPool::workerMain( void* pool )
+{
+	static_cast<ThreadPool*>(pool)->wait();
+	return NULL;
+}
+
+/* Worker loop: sleep until a new generation (or stop), claim chunks, report done */
+void	ThreadPool::wait( void )
+{
+	unsigned long	seen = 0;
+
+	pthread_mutex_lock(&_mutex);
+	while (true)
+	{
+		while (!_stop && _generation == seen)
+			pthread_cond_wait(&_wake, &_mutex);
+		if (_stop)
+			break;
+		seen = _generation;
+		pthread_mutex_unlock(&_mutex);
+
+		work();
+
+		pthread_mutex_lock(&_mutex);
+		if (--_busy == 0)
+			pthread_cond_signal(&_done);
+	}
+	pthread_mutex_unlock(&_mutex);
+}
+
+void	ThreadPool::work( void )
+{
+	std::size_t	chunk;
+
+	while ((chunk = __sync_fetch_and_add(&_next, 1)) < _chunks)
+	{
+		try
+		{
+			_task->run(chunk);
+		}
+		catch (...)
+		{
+			_failed = true;
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <pthread.h>
+
+/*
+**	Work handed to ThreadPool::run: run() is called once for every chunk
+**	number in [0, chunks), from any thread of the pool
+*/
+class PoolTask
+{
+public:
+	virtual ~PoolTask() {}
+	virtual void	run( std::size_t chunk ) = 0;
+};
+
+/* Number of online processors (1 if it cannot be determined) */
+std::size_t	hardwareThreads( void );
+
+/*
+**	Fixed set of POSIX threads kept alive between calls, so a parallel loop
+**	pays a wake-up instead of a thread creation. run() lets the workers and
+**	the calling thread claim chunks from a shared atomic counter (cheap load
+**	balancing when chunks cost different amounts) and returns once every
+**	chunk is done. If a chunk throws, the remaining chunks still run and
+**	run() throws std::runtime_error. Workers that cannot be created are
+**	dropped: the pool still works with fewer threads, down to the caller alone.
+**	One run() at a time per pool.
+*/
+class ThreadPool
+{
+public:
+	/*** parameterized constructor: threads counts the caller, 0 means one per processor ***/
+	explicit ThreadPool( std::size_t threads = 0 );
+	/*** destructor ***/
+	~ThreadPool();
+
+	/*** getter ***/
+	std::size_t	size( void ) const;
+
+	void	run( PoolTask& task, std::size_t chunks );
+
+
+private:
+	/*** copy constructor / assignment operator: a pool owns its threads ***/
+	ThreadPool( const ThreadPool& other );
+	ThreadPool& operator=( const ThreadPool& other );
+
+	static void*	workerMain( void* pool );
+	void			wait( void );
+	void			work( void );
+
+	std::vector<pthread_t>	_workers;
+	pthread_mutex_t			_mutex;
+	pthread_cond_t			_wake;
+	pthread_cond_t			_done;
+	PoolTask*				_task;
+	std::size_t				_chunks;
+	volatile std::size_t	_next;
+	volatile bool			_failed;
+	std::size_t				_busy;
+	unsigned long			_generation;
+	bool					_stop;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define ITER_H
 
 #include <iostream>
+#include "ThreadPool.hpp"
 
 /*
 **	Template function to apply a given function to each element
@@ -15,4 +16,162 @@ void	iter(T* array, const size_t& len, const Func& f)
 		f(array[i]);
 }
 
-#endif
\ No newline at end of file
+/*
+**	Output variant: out[i] = f(in[i]). f returns its result instead of
+**	modifying through a reference, so for a cheap inlinable f the block of
+**	ITER_BLOCK calls has no dependencies and compiles to packed SIMD
+**	instructions. Results are staged in a local block before the store,
+**	so in and out may be the same array.
+*/
+static const size_t	ITER_BLOCK = 16;
+
+template <typename T, typename U, typename Func>
+void	iter(const T* in, const size_t& len, U* out, const Func& f)
+{
+	size_t	i = 0;
+
+	for (; i + ITER_BLOCK <= len; i += ITER_BLOCK)
+	{
+		const T*	block = in + i;
+		U			results[ITER_BLOCK];
+#pragma GCC unroll 16
+		for (size_t j = 0; j < ITER_BLOCK; j++)
+			results[j] = f(block[j]);
+#pragma GCC unroll 16
+		for (size_t j = 0; j < ITER_BLOCK; j++)
+			out[i + j] = results[j];
+	}
+	for (const T* tail = in + i; tail != in + len; ++tail)
+		out[tail - in] = f(*tail);
+}
+
+/*
+**	Chunking for the parallel variants. Chunks are a whole number of cache
+**	lines long and, past the first one, start on a cache-line boundary of
+**	the written array, so two threads never write to the same line. Chunks
+**	are at least ITER_MIN_CHUNK_BYTES (a thread wake-up is worth a few
+**	microseconds of work) and there are up to ITER_CHUNKS_PER_THREAD per
+**	thread so an uneven f still balances.
+*/
+static const size_t	ITER_CACHE_LINE = 64;
+static const size_t	ITER_MIN_CHUNK_BYTES = 64 * 1024;
+static const size_t	ITER_CHUNKS_PER_THREAD = 8;
+
+template <typename T>
+class IterChunks
+{
+public:
+	IterChunks( const T* array, size_t len, size_t threads ) : _len(len), _offset(0)
+	{
+		size_t	step = ITER_CACHE_LINE;
+
+		/* smallest element count spanning whole lines */
+		while (step % sizeof(T) != 0)
+			step += ITER_CACHE_LINE;
+		step /= sizeof(T);
+
+		/* first element starting a line, if any does */
+		size_t	address = reinterpret_cast<size_t>(array);
+		for (size_t i = 0; i < step; i++)
+			if ((address + i * sizeof(T)) % ITER_CACHE_LINE == 0)
+			{
+				_offset = i;
+				break;
+			}
+
+		size_t	chunk = len / (threads * ITER_CHUNKS_PER_THREAD);
+		if (chunk < ITER_MIN_CHUNK_BYTES / sizeof(T))
+			chunk = ITER_MIN_CHUNK_BYTES / sizeof(T);
+		_chunk = (chunk + step - 1) / step * step;
+	}
+
+	size_t	count( void ) const
+	{
+		return (_len > _offset) ? (_len - _offset + _chunk - 1) / _chunk : 1;
+	}
+
+	size_t	begin( size_t chunk ) const { return (chunk == 0) ? 0 : boundary(chunk); }
+	size_t	end( size_t chunk ) const { return boundary(chunk + 1); }
+
+
+private:
+	size_t	_len;
+	size_t	_offset;
+	size_t	_chunk;
+
+	size_t	boundary( size_t chunk ) const
+	{
+		size_t	index = _offset + chunk * _chunk;
+		return (index < _len) ? index : _len;
+	}
+};
+
+template <typename T, typename Func>
+class IterTask : public PoolTask
+{
+public:
+	IterTask( T* array, const IterChunks<T>& chunks, const Func& f ) : _array(array), _chunks(chunks), _f(f) {}
+
+	void	run( size_t chunk )
+	{
+		size_t	begin = _chunks.begin(chunk);
+		size_t	len = _chunks.end(chunk) - begin;
+
+		iter(_array + begin, len, _f);
+	}
+
+
+private:
+	T*						_array;
+	const IterChunks<T>&	_chunks;
+	const Func&				_f;
+};
+
+template <typename T, typename U, typename Func>
+class IterOutputTask : public PoolTask
+{
+public:
+	IterOutputTask( const T* in, U* out, const IterChunks<U>& chunks, const Func& f )
+		: _in(in), _out(out), _chunks(chunks), _f(f) {}
+
+	void	run( size_t chunk )
+	{
+		size_t	begin = _chunks.begin(chunk);
+		size_t	len = _chunks.end(chunk) - begin;
+
+		iter(_in + begin, len, _out + begin, _f);
+	}
+
+
+private:
+	const T*				_in;
+	U*						_out;
+	const IterChunks<U>&	_chunks;
+	const Func&				_f;
+};
+
+/*
+**	Parallel variants: same results as iter, the range split across pool.
+**	f is called concurrently from several threads, so it must be safe to
+**	call that way (no shared mutable state) and the order of the calls is
+**	unspecified. Arrays too small for two chunks run on the calling thread.
+*/
+template <typename T, typename Func>
+void	parallelIter(ThreadPool& pool, T* array, const size_t& len, const Func& f)
+{
+	IterChunks<T>		chunks(array, len, pool.size());
+	IterTask<T, Func>	task(array, chunks, f);
+
+	pool.run(task, chunks.count());
+}
+
+template <typename T, typename U, typename Func>
+void	parallelIter(ThreadPool& pool, const T* in, const size_t& len, U* out, const Func& f)
+{
+	IterChunks<U>				chunks(out, len, pool.size());
+	IterOutputTask<T, U, Func>	task(in, out, chunks, f);
+
+	pool.run(task, chunks.count());
+}
+
+#endif
@@ -1,10 +1,69 @@
 # include "iter.h"
+# include "Pipeline.hpp"
+# include <vector>
+# include <ctime>
+# include <functional>
+# include <algorithm>
 
 static void doubleElement( int& element );
 template <typename T>
 static void incrementElement( T& element );
 template <typename T>
 static void	printElement( const T& element );
+static double	nowMs( void );
+static void		benchmarkIter( const char* name, size_t len, int repeats, ThreadPool& pool );
+static void		benchmarkPipeline( size_t len, int repeats );
+
+/* Cheap functors: one multiply-add per element, memory-bound at large sizes */
+struct ScaleInPlace
+{
+	void	operator()( float& x ) const { x = x * 0.5f + 1.0f; }
+};
+
+struct Scale
+{
+	float	operator()( float x ) const { return x * 0.5f + 1.0f; }
+};
+
+/* More cheap in-place stages for the pipeline benchmark */
+struct AddQuarter
+{
+	void	operator()( float& x ) const { x += 0.25f; }
+};
+
+struct ClampAtTwo
+{
+	void	operator()( float& x ) const { x = (x < 2.0f) ? x : 2.0f; }
+};
+
+/* Sum through iter: the functor can only write through a pointer */
+struct SumInto
+{
+	double*	total;
+
+	explicit SumInto( double* sum ) : total(sum) {}
+	void	operator()( const float& x ) const { *total += x; }
+};
+
+/* Expensive functors: 64 dependent divide steps per element, compute-bound */
+struct IterateInPlace
+{
+	void	operator()( float& x ) const
+	{
+		for (int k = 0; k < 64; k++)
+			x = x * 0.75f + 1.0f / (1.0f + x * x);
+	}
+};
+
+struct Iterate
+{
+	float	operator()( float x ) const
+	{
+		for (int k = 0; k < 64; k++)
+			x = x * 0.75f + 1.0f / (1.0f + x * x);
+		return x;
+	}
+};
 
 int main()
 {
@@ -72,6 +131,56 @@ int main()
 	std::cout << std::endl;
 	std::cout << "---------------------------" << std::endl;
 
+	/*
+	**	Output variant and parallel variants give the same results. The
+	**	checks use four threads whatever the machine, so the threaded path
+	**	runs even where the default pool (one per processor) has no worker.
+	*/
+	std::cout << "Test with output array and thread pool:" << std::endl;
+	ThreadPool pool;
+	ThreadPool four(4);
+	float squares[] = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f};
+	float halves[5];
+	iter(squares, 5, halves, Scale());
+	std::cout << "x * 0.5 + 1 into a second array: ";
+	iter(halves, 5, printElement<float>);
+	std::cout << std::endl;
+
+	std::vector<float> sequential(1000003, 3.0f);
+	std::vector<float> parallel(sequential);
+	iter(&sequential[0], sequential.size(), IterateInPlace());
+	parallelIter(four, &parallel[0], parallel.size(), IterateInPlace());
+	std::cout << "parallelIter on " << four.size() << " thread(s) matches iter: "
+		<< (sequential == parallel ? "yes" : "no") << std::endl;
+	parallelIter(four, &parallel[0], parallel.size(), &parallel[0], Scale());
+	iter(&sequential[0], sequential.size(), &sequential[0], Scale());
+	std::cout << "In-place output variant matches: " << (sequential == parallel ? "yes" : "no") << std::endl;
+	std::cout << "---------------------------" << std::endl;
+
+	/* Benchmarks: sequential iter against the output and parallel variants */
+	std::cout << "Benchmarks (" << hardwareThreads() << " processor(s) online):" << std::endl;
+	benchmarkIter("cheap", 65536, 2000, pool);
+	benchmarkIter("cheap", 65536, 2000, four);
+	benchmarkIter("cheap", 10000000, 20, pool);
+	benchmarkIter("cheap", 10000000, 20, four);
+	benchmarkIter("expensive", 1000000, 2, pool);
+	benchmarkIter("expensive", 1000000, 2, four);
+	std::cout << "---------------------------" << std::endl;
+
+	/* Fused pipeline: several functions and a reduction in one pass */
+	std::cout << "Test with fused pipeline:" << std::endl;
+	int pipeArray[] = {1, 2, 3, 4, 5};
+	std::cout << "double, increment, print in one pass: ";
+	pipeline(doubleElement).then(incrementElement<int>).then(printElement<int>).run(pipeArray, 5);
+	std::cout << std::endl;
+	std::cout << "double again and sum: "
+		<< pipeline(doubleElement).reduce(pipeArray, 5, 0, std::plus<int>()) << std::endl;
+	std::cout << "Pipeline passed to iter: ";
+	iter(pipeArray, 5, pipeline(incrementElement<int>).then(printElement<int>));
+	std::cout << std::endl;
+	benchmarkPipeline(128 * 1024 * 1024, 3);
+	std::cout << "---------------------------" << std::endl;
+
 	return 0;
 }
 
@@ -90,4 +199,112 @@ static void incrementElement( T& element ) {
 template <typename T>
 static void	printElement( const T& element ) {
 	std::cout << element << " ";
-}
\ No newline at end of file
+}
+
+static double	nowMs( void )
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/*
+**	Runs the four forms over len floats, repeats times each, and prints the
+**	time per pass (the in-place forms start each pass from a fresh copy,
+**	not timed); the checksum of each output is compared so the passes
+**	cannot be optimized away
+*/
+static void	benchmarkIter( const char* name, size_t len, int repeats, ThreadPool& pool )
+{
+	const bool			cheap = (name[0] == 'c');
+	std::vector<float>	in(len, 2.0f);
+	std::vector<float>	inPlace(len);
+	std::vector<float>	out(len);
+	double				times[4];
+	double				sums[4];
+	double				start;
+
+	for (int form = 0; form < 4; form++)
+	{
+		times[form] = 0.0;
+		for (int r = 0; r < repeats; r++)
+		{
+			if (form < 2)
+				inPlace = in;
+			start = nowMs();
+			if (form == 0 && cheap)
+				iter(&inPlace[0], len, ScaleInPlace());
+			else if (form == 0)
+				iter(&inPlace[0], len, IterateInPlace());
+			else if (form == 1 && cheap)
+				parallelIter(pool, &inPlace[0], len, ScaleInPlace());
+			else if (form == 1)
+				parallelIter(pool, &inPlace[0], len, IterateInPlace());
+			else if (form == 2 && cheap)
+				iter(&in[0], len, &out[0], Scale());
+			else if (form == 2)
+				iter(&in[0], len, &out[0], Iterate());
+			else if (cheap)
+				parallelIter(pool, &in[0], len, &out[0], Scale());
+			else
+				parallelIter(pool, &in[0], len, &out[0], Iterate());
+			times[form] += nowMs() - start;
+		}
+		times[form] /= repeats;
+		const std::vector<float>& result = (form < 2) ? inPlace : out;
+		sums[form] = 0.0;
+		for (size_t i = 0; i < len; i += 997)
+			sums[form] += result[i];
+	}
+
+	std::cout << "  " << name << ", " << len << " floats, " << pool.size() << " thread(s): iter "
+		<< times[0] << " ms, parallelIter " << times[1] << " ms (" << times[0] / times[1]
+		<< "x), output iter " << times[2] << " ms (" << times[0] / times[2]
+		<< "x), parallel output " << times[3] << " ms (" << times[0] / times[3] << "x)"
+		<< (sums[0] == sums[1] && sums[0] == sums[2] && sums[0] == sums[3] ? "" : " RESULTS DIFFER")
+		<< std::endl;
+}
+
+/*
+**	Three cheap stages and a sum over len floats (sized past the last-level
+**	cache): four iter passes, each streaming the array from memory, against
+**	one fused pass. The array is refilled before each repeat, untimed.
+*/
+static void	benchmarkPipeline( size_t len, int repeats )
+{
+	std::vector<float>	array(len);
+	double				separateMs = 0.0;
+	double				fusedMs = 0.0;
+	double				runMs = 0.0;
+	double				separateSum = 0.0;
+	double				fusedSum = 0.0;
+	double				start;
+
+	for (int r = 0; r < repeats; r++)
+	{
+		std::fill(array.begin(), array.end(), 1.0f);
+		start = nowMs();
+		iter(&array[0], len, ScaleInPlace());
+		iter(&array[0], len, AddQuarter());
+		iter(&array[0], len, ClampAtTwo());
+		iter(&array[0], len, SumInto(&separateSum));
+		separateMs += nowMs() - start;
+
+		std::fill(array.begin(), array.end(), 1.0f);
+		start = nowMs();
+		fusedSum += pipeline(ScaleInPlace()).then(AddQuarter()).then(ClampAtTwo())
+			.reduce(&array[0], len, 0.0, std::plus<double>());
+		fusedMs += nowMs() - start;
+
+		std::fill(array.begin(), array.end(), 1.0f);
+		start = nowMs();
+		pipeline(ScaleInPlace()).then(AddQuarter()).then(ClampAtTwo()).run(&array[0], len);
+		runMs += nowMs() - start;
+	}
+
+	std::cout << "  " << len << " floats (" << len * sizeof(float) / (1024 * 1024) << " MiB), 3 stages + sum: "
+		<< "4 iter passes " << separateMs / repeats << " ms, fused reduce " << fusedMs / repeats
+		<< " ms (" << separateMs / fusedMs << "x), fused run without sum " << runMs / repeats << " ms"
+		<< (separateSum == fusedSum ? "" : " SUMS DIFFER") << std::endl;
+}
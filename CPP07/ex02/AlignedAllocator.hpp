@@ -0,0 +1,82 @@
+#ifndef ALIGNEDALLOCATOR_HPP
+#define ALIGNEDALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+/*
+**	Default allocator of Array: every buffer comes from posix_memalign and
+**	starts on an Alignment-byte boundary (a cache line by default, enough
+**	for any SIMD load).
+**	With HugePages, buffers of at least HUGE_PAGE_SIZE bytes are mapped with
+**	mmap on a huge-page boundary and advised for transparent huge pages,
+**	which saves TLB misses on large arrays that live long and are traversed
+**	many times. It is opt-in: each such buffer costs a few system calls and
+**	fresh page faults, far more than malloc reusing freed memory.
+**	Same interface as std::allocator, so any allocator (arena, pool) can
+**	replace it as the second parameter of Array.
+*/
+template <typename T, std::size_t Alignment = 64, bool HugePages = false>
+class AlignedAllocator
+{
+public:
+	typedef T					value_type;
+	typedef T*					pointer;
+	typedef const T*			const_pointer;
+	typedef T&					reference;
+	typedef const T&			const_reference;
+	typedef std::size_t			size_type;
+	typedef std::ptrdiff_t		difference_type;
+
+	template <typename U>
+	struct rebind { typedef AlignedAllocator<U, Alignment, HugePages> other; };
+
+	static const std::size_t	alignment = Alignment;
+	static const std::size_t	HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	/*** constructor ***/
+	AlignedAllocator();
+	/*** copy constructor ***/
+	AlignedAllocator( const AlignedAllocator& other );
+	template <typename U>
+	AlignedAllocator( const AlignedAllocator<U, Alignment, HugePages>& other );
+	/*** assignment operator ***/
+	AlignedAllocator& operator=( const AlignedAllocator& other );
+	/*** destructor ***/
+	~AlignedAllocator();
+
+	/*** allocation: throws std::bad_alloc ***/
+	T*			allocate( size_type n, const void* hint = 0 );
+	void		deallocate( T* elements, size_type n );
+	size_type	max_size( void ) const;
+
+private:
+	static std::size_t	mappedSize( std::size_t bytes );
+};
+
+/* Stateless: any two instances can free each other's buffers */
+template <typename T, typename U, std::size_t Alignment, bool HugePages>
+bool operator==( const AlignedAllocator<T, Alignment, HugePages>&, const AlignedAllocator<U, Alignment, HugePages>& );
+template <typename T, typename U, std::size_t Alignment, bool HugePages>
+bool operator!=( const AlignedAllocator<T, Alignment, HugePages>&, const AlignedAllocator<U, Alignment, HugePages>& );
+
+/*
+**	Alignment an allocator guarantees, used by the bulk operations:
+**	alignof(T) at least for any allocator, Alignment for AlignedAllocator
+*/
+template <typename Alloc>
+struct AllocatorAlignment
+{
+	static const std::size_t value = __alignof__(typename Alloc::value_type);
+};
+
+template <typename T, std::size_t Alignment, bool HugePages>
+struct AllocatorAlignment< AlignedAllocator<T, Alignment, HugePages> >
+{
+	static const std::size_t value = Alignment;
+};
+
+/* Include the implementation file */
+#include "AlignedAllocator.tpp"
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef ALIGNEDALLOCATOR_TPP
+#define ALIGNEDALLOCATOR_TPP
+
+#include "AlignedAllocator.hpp"
+#include <cstdlib>
+#include <sys/mman.h>
+
+template <typename T, std::size_t Alignment, bool HugePages>
+const std::size_t AlignedAllocator<T, Alignment, HugePages>::alignment;
+
+template <typename T, std::size_t Alignment, bool HugePages>
+const std::size_t AlignedAllocator<T, Alignment, HugePages>::HUGE_PAGE_SIZE;
+
+/*** constructor ***/
+template <typename T, std::size_t Alignment, bool HugePages>
+AlignedAllocator<T, Alignment, HugePages>::AlignedAllocator() {}
+
+/*** copy constructor ***/
+template <typename T, std::size_t Alignment, bool HugePages>
+AlignedAllocator<T, Alignment, HugePages>::AlignedAllocator( const AlignedAllocator& ) {}
+
+template <typename T, std::size_t Alignment, bool HugePages>
+template <typename U>
+AlignedAllocator<T, Alignment, HugePages>::AlignedAllocator( const AlignedAllocator<U, Alignment, HugePages>& ) {}
+
+/*** assignment operator ***/
+template <typename T, std::size_t Alignment, bool HugePages>
+AlignedAllocator<T, Alignment, HugePages>& AlignedAllocator<T, Alignment, HugePages>::operator=( const AlignedAllocator& )
+{
+	return *this;
+}
+
+/*** destructor ***/
+template <typename T, std::size_t Alignment, bool HugePages>
+AlignedAllocator<T, Alignment, HugePages>::~AlignedAllocator() {}
+
+/*** allocation ***/
+/*
+**	Large buffers with HugePages: one huge page more than needed is mapped,
+**	then the parts before the first huge-page boundary and after the buffer
+**	are unmapped, so the kernel can back the whole buffer with 2 MiB pages
+*/
+template <typename T, std::size_t Alignment, bool HugePages>
+T*	AlignedAllocator<T, Alignment, HugePages>::allocate( size_type n, const void* )
+{
+	if (n == 0)
+		return NULL;
+	if (n > max_size())
+		throw std::bad_alloc();
+
+	std::size_t bytes = n * sizeof(T);
+	if (!HugePages || bytes < HUGE_PAGE_SIZE)
+	{
+		void* memory = NULL;
+		if (posix_memalign(&memory, Alignment < sizeof(void*) ? sizeof(void*) : Alignment, bytes) != 0)
+			throw std::bad_alloc();
+		return static_cast<T*>(memory);
+	}
+
+	std::size_t size = mappedSize(bytes);
+	void* mapped = mmap(NULL, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapped == MAP_FAILED)
+		throw std::bad_alloc();
+
+	char* start = static_cast<char*>(mapped);
+	std::size_t head = (HUGE_PAGE_SIZE - reinterpret_cast<std::size_t>(start) % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+	if (head > 0)
+		munmap(start, head);
+	munmap(start + head + size, HUGE_PAGE_SIZE - head);
+#ifdef MADV_HUGEPAGE
+	madvise(start + head, size, MADV_HUGEPAGE);
+#endif
+	return reinterpret_cast<T*>(start + head);
+}
+
+template <typename T, std::size_t Alignment, bool HugePages>
+void	AlignedAllocator<T, Alignment, HugePages>::deallocate( T* elements, size_type n )
+{
+	if (elements == NULL)
+		return;
+	if (!HugePages || n * sizeof(T) < HUGE_PAGE_SIZE)
+		std::free(elements);
+	else
+		munmap(elements, mappedSize(n * sizeof(T)));
+}
+
+template <typename T, std::size_t Alignment, bool HugePages>
+typename AlignedAllocator<T, Alignment, HugePages>::size_type	AlignedAllocator<T, Alignment, HugePages>::max_size( void ) const
+{
+	return (static_cast<std::size_t>(-1) - HUGE_PAGE_SIZE) / sizeof(T) / 2;
+}
+
+/* Mapped buffers are whole huge pages */
+template <typename T, std::size_t Alignment, bool HugePages>
+std::size_t	AlignedAllocator<T, Alignment, HugePages>::mappedSize( std::size_t bytes )
+{
+	return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+template <typename T, typename U, std::size_t Alignment, bool HugePages>
+bool operator==( const AlignedAllocator<T, Alignment, HugePages>&, const AlignedAllocator<U, Alignment, HugePages>& )
+{
+	return true;
+}
+
+template <typename T, typename U, std::size_t Alignment, bool HugePages>
+bool operator!=( const AlignedAllocator<T, Alignment, HugePages>&, const AlignedAllocator<U, Alignment, HugePages>& )
+{
+	return false;
+}
+
+#endif
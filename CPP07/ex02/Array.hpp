@@ -3,15 +3,42 @@
 
 #include <stdexcept>
 #include <iostream>
+#include "AlignedAllocator.hpp"
 
+/*
+**	Compile-time flag: T can be copied with memcpy and needs no destructor call.
+**	C++98 has no type traits, GCC's builtins answer it.
+*/
 template <typename T>
+struct IsTriviallyCopyable
+{
+	static const bool value = __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T);
+};
+
+/* Tag type selecting the memcpy or the element-wise overloads */
+template <bool Trivial>
+struct TrivialTag {};
+
+/*
+**	Alloc supplies the storage: AlignedAllocator by default (64-byte aligned),
+**	AlignedAllocator<T, 64, true> for huge pages on large long-lived arrays,
+**	or any std::allocator-like type such as an arena or a pool. Each Array
+**	keeps its own copy of the allocator.
+*/
+template <typename T, typename Alloc = AlignedAllocator<T> >
 class Array
 {
 public:
+	typedef Alloc		allocator_type;
+
+	/*** iterators: plain pointers over the contiguous storage ***/
+	typedef T*			iterator;
+	typedef const T*	const_iterator;
+
 	/*** constructor ***/
 	Array();
 	/*** parameterized constructor ***/
-	Array( unsigned int n );
+	Array( unsigned int n, const Alloc& alloc = Alloc() );
 	/*** copy constructor ***/
 	Array( const Array& other );
 	/*** assignment operator ***/
@@ -21,15 +48,40 @@ public:
 
 	/*** getter ***/
 	unsigned int	size( void ) const;
+	Alloc			get_allocator( void ) const;
 
 	/*** subscript operator override ***/
 	T& operator[]( unsigned int index );
 	const T& operator[]( unsigned int index ) const;
 
+	/*** unchecked access, for hot loops: index must be < size() ***/
+	T& unchecked( unsigned int index );
+	const T& unchecked( unsigned int index ) const;
+	T* data( void );
+	const T* data( void ) const;
+	iterator begin( void );
+	iterator end( void );
+	const_iterator begin( void ) const;
+	const_iterator end( void ) const;
+
+	/*** resize: keeps the first min(size, n) elements, default-initializes the others ***/
+	void	resize( unsigned int n );
+
 
 private:
+	Alloc			_alloc;
 	T*				_elements;
 	unsigned int	_size;
+
+	/*** raw storage and placement construction ***/
+	T*			allocate( unsigned int n );
+	void		deallocate( T* elements, unsigned int n );
+	static void	construct( T* elements, unsigned int n );
+	static void	copyConstruct( T* dest, const T* src, unsigned int n, TrivialTag<true> );
+	static void	copyConstruct( T* dest, const T* src, unsigned int n, TrivialTag<false> );
+	static void	copyAssign( T* dest, const T* src, unsigned int n, TrivialTag<true> );
+	static void	copyAssign( T* dest, const T* src, unsigned int n, TrivialTag<false> );
+	static void	destroy( T* elements, unsigned int n );
 };
 
 /* Include the implementation file */
@@ -3,76 +3,256 @@
 
 #include "Array.hpp"
 #include <iostream>
+#include <cstring>
+#include <new>
 
 /*** constructor ***/
-template <typename T>
-Array<T>::Array() : _elements(NULL), _size(0) {}
+template <typename T, typename Alloc>
+Array<T, Alloc>::Array() : _alloc(), _elements(NULL), _size(0) {}
 
 /*** parameterized constructor ***/
 /*
-**	Allocate memory for 'n' elements
+**	One raw allocation for 'n' elements, then placement default-initialization:
+**	for trivial types (int, double, POD structs) that is no work at all, as with new T[n]
 */
-template <typename T>
-Array<T>::Array( unsigned int n ) : _size(n)
+template <typename T, typename Alloc>
+Array<T, Alloc>::Array( unsigned int n, const Alloc& alloc ) : _alloc(alloc), _elements(allocate(n)), _size(n)
 {
-	_elements = new T[_size];
+	try
+	{
+		construct(_elements, _size);
+	}
+	catch (...)
+	{
+		deallocate(_elements, _size);
+		throw;
+	}
 }
 
 /*** copy constructor ***/
-template <typename T>
-Array<T>::Array( const Array& other ) : _elements(NULL), _size(other._size)
+template <typename T, typename Alloc>
+Array<T, Alloc>::Array( const Array& other )
+	: _alloc(other._alloc), _elements(allocate(other._size)), _size(other._size)
 {
-	if (_size > 0)
+	try
 	{
-		_elements = new T[_size];
-		for (unsigned int i = 0; i < _size; i++)
-			this->_elements[i] = other._elements[i];
+		copyConstruct(_elements, other._elements, _size, TrivialTag<IsTriviallyCopyable<T>::value>());
+	}
+	catch (...)
+	{
+		deallocate(_elements, _size);
+		throw;
 	}
 }
 
 /*** assignment operator ***/
-template <typename T>
-Array<T>& Array<T>::operator=( const Array& other )
+/*
+**	Same size: the elements are assigned in place, no allocation.
+**	Otherwise the copy is built in new storage before the old one is released,
+**	so a throwing element copy leaves *this unchanged.
+*/
+template <typename T, typename Alloc>
+Array<T, Alloc>& Array<T, Alloc>::operator=( const Array& other )
 {
 	if (this != &other)
 	{
-		delete[] _elements;
-		_size = other._size;
-		if (_size > 0)
+		if (_size == other._size)
+			copyAssign(_elements, other._elements, _size, TrivialTag<IsTriviallyCopyable<T>::value>());
+		else
 		{
-			_elements = new T[_size];
-			for (unsigned int i = 0; i < _size; i++)
-				this->_elements[i] = other._elements[i];
+			T* elements = allocate(other._size);
+			try
+			{
+				copyConstruct(elements, other._elements, other._size, TrivialTag<IsTriviallyCopyable<T>::value>());
+			}
+			catch (...)
+			{
+				deallocate(elements, other._size);
+				throw;
+			}
+			destroy(_elements, _size);
+			deallocate(_elements, _size);
+			_elements = elements;
+			_size = other._size;
 		}
-		else
-			this->_elements = NULL;
 	}
 	return *this;
 }
 
 /*** destructor ***/
-template <typename T>
-Array<T>::~Array() { delete[] _elements; }
+template <typename T, typename Alloc>
+Array<T, Alloc>::~Array()
+{
+	destroy(_elements, _size);
+	deallocate(_elements, _size);
+}
 
 /*** getter ***/
-template <typename T>
-unsigned int	Array<T>::size( void ) const { return _size; }
+template <typename T, typename Alloc>
+unsigned int	Array<T, Alloc>::size( void ) const { return _size; }
+
+template <typename T, typename Alloc>
+Alloc	Array<T, Alloc>::get_allocator( void ) const { return _alloc; }
 
 /*** subscript operator override ***/
-template <typename T>
-T& Array<T>::operator[]( unsigned int index )
+template <typename T, typename Alloc>
+T& Array<T, Alloc>::operator[]( unsigned int index )
 {
 	if (index >= _size)
 		throw std::out_of_range("Index out of range");
 	return _elements[index];
 }
 
-template <typename T>
-const T& Array<T>::operator[]( unsigned int index ) const
+template <typename T, typename Alloc>
+const T& Array<T, Alloc>::operator[]( unsigned int index ) const
 {
 	if (index >= _size)
 		throw std::out_of_range("Index out of range");
 	return _elements[index];
 }
 
+/*** unchecked access ***/
+template <typename T, typename Alloc>
+T& Array<T, Alloc>::unchecked( unsigned int index ) { return _elements[index]; }
+
+template <typename T, typename Alloc>
+const T& Array<T, Alloc>::unchecked( unsigned int index ) const { return _elements[index]; }
+
+template <typename T, typename Alloc>
+T* Array<T, Alloc>::data( void ) { return _elements; }
+
+template <typename T, typename Alloc>
+const T* Array<T, Alloc>::data( void ) const { return _elements; }
+
+template <typename T, typename Alloc>
+typename Array<T, Alloc>::iterator Array<T, Alloc>::begin( void ) { return _elements; }
+
+template <typename T, typename Alloc>
+typename Array<T, Alloc>::iterator Array<T, Alloc>::end( void ) { return _elements + _size; }
+
+template <typename T, typename Alloc>
+typename Array<T, Alloc>::const_iterator Array<T, Alloc>::begin( void ) const { return _elements; }
+
+template <typename T, typename Alloc>
+typename Array<T, Alloc>::const_iterator Array<T, Alloc>::end( void ) const { return _elements + _size; }
+
+/*** resize ***/
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::resize( unsigned int n )
+{
+	if (n == _size)
+		return;
+
+	unsigned int kept = (n < _size) ? n : _size;
+	T* elements = allocate(n);
+
+	try
+	{
+		copyConstruct(elements, _elements, kept, TrivialTag<IsTriviallyCopyable<T>::value>());
+		try
+		{
+			construct(elements + kept, n - kept);
+		}
+		catch (...)
+		{
+			destroy(elements, kept);
+			throw;
+		}
+	}
+	catch (...)
+	{
+		deallocate(elements, n);
+		throw;
+	}
+	destroy(_elements, _size);
+	deallocate(_elements, _size);
+	_elements = elements;
+	_size = n;
+}
+
+/*** raw storage and placement construction ***/
+template <typename T, typename Alloc>
+T*	Array<T, Alloc>::allocate( unsigned int n )
+{
+	if (n == 0)
+		return NULL;
+	return _alloc.allocate(n);
+}
+
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::deallocate( T* elements, unsigned int n )
+{
+	if (elements != NULL)
+		_alloc.deallocate(elements, n);
+}
+
+/*
+**	Default-initializes n elements, the same initialization new T[n] performs.
+**	If one throws, the elements built so far are destroyed (the caller owns the storage).
+*/
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::construct( T* elements, unsigned int n )
+{
+	unsigned int i = 0;
+
+	try
+	{
+		for (; i < n; i++)
+			new (elements + i) T;
+	}
+	catch (...)
+	{
+		destroy(elements, i);
+		throw;
+	}
+}
+
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::copyConstruct( T* dest, const T* src, unsigned int n, TrivialTag<true> )
+{
+	if (n > 0)
+		std::memcpy(dest, src, static_cast<std::size_t>(n) * sizeof(T));
+}
+
+/* Copy-constructs n elements; if one throws, the copies made so far are destroyed */
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::copyConstruct( T* dest, const T* src, unsigned int n, TrivialTag<false> )
+{
+	unsigned int i = 0;
+
+	try
+	{
+		for (; i < n; i++)
+			new (dest + i) T(src[i]);
+	}
+	catch (...)
+	{
+		destroy(dest, i);
+		throw;
+	}
+}
+
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::copyAssign( T* dest, const T* src, unsigned int n, TrivialTag<true> )
+{
+	if (n > 0)
+		std::memmove(dest, src, static_cast<std::size_t>(n) * sizeof(T));
+}
+
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::copyAssign( T* dest, const T* src, unsigned int n, TrivialTag<false> )
+{
+	for (unsigned int i = 0; i < n; i++)
+		dest[i] = src[i];
+}
+
+template <typename T, typename Alloc>
+void	Array<T, Alloc>::destroy( T* elements, unsigned int n )
+{
+	if (__has_trivial_destructor(T))
+		return;
+	for (unsigned int i = 0; i < n; i++)
+		elements[i].~T();
+}
+
 #endif
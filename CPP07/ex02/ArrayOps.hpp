@@ -0,0 +1,41 @@
+#ifndef ARRAYOPS_HPP
+#define ARRAYOPS_HPP
+
+#include "Array.hpp"
+
+/*
+**	Bulk operations over whole Arrays.
+**	The loops run in blocks of BULK_BLOCK elements with a fixed trip count,
+**	which GCC turns into packed SIMD instructions at -O2, and tell the
+**	compiler the alignment the allocator guarantees (64 bytes with
+**	AlignedAllocator), so the vector loads and stores need no peeling or
+**	unaligned fallback. Any allocator works; only the alignment hint changes.
+*/
+
+/* Elements per block of the bulk loops */
+static const unsigned int	BULK_BLOCK = 16;
+
+/*** every element = value ***/
+template <typename T, typename Alloc>
+void	bulkFill( Array<T, Alloc>& array, const T& value );
+
+/*** dst = src, element-wise (memcpy for trivially copyable T): throws std::invalid_argument if sizes differ ***/
+template <typename T, typename AllocSrc, typename AllocDst>
+void	bulkCopy( const Array<T, AllocSrc>& src, Array<T, AllocDst>& dst );
+
+/*** dst[i] = op(src[i]): throws std::invalid_argument if sizes differ ***/
+template <typename T, typename AllocSrc, typename U, typename AllocDst, typename Op>
+void	bulkTransform( const Array<T, AllocSrc>& src, Array<U, AllocDst>& dst, Op op );
+
+/*
+**	op(init, elements...): op must be associative and commutative, as the
+**	blocks are folded into BULK_BLOCK partial results (for floating point the
+**	result may differ from a left-to-right loop in the last bits)
+*/
+template <typename T, typename Alloc, typename Op>
+T		bulkReduce( const Array<T, Alloc>& array, T init, Op op );
+
+/* Include the implementation file */
+#include "ArrayOps.tpp"
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef ARRAYOPS_TPP
+#define ARRAYOPS_TPP
+
+#include "ArrayOps.hpp"
+#include <cstring>
+
+/* The pointer with the alignment Alloc guarantees made known to the optimizer */
+template <typename Alloc, typename T>
+T*	assumeAligned( T* elements )
+{
+	return static_cast<T*>(__builtin_assume_aligned(const_cast<void*>(static_cast<const void*>(elements)),
+		AllocatorAlignment<Alloc>::value));
+}
+
+inline void	checkSameSize( unsigned int src, unsigned int dst )
+{
+	if (src != dst)
+		throw std::invalid_argument("Array sizes differ");
+}
+
+/*** fill ***/
+template <typename T, typename Alloc>
+void	bulkFill( Array<T, Alloc>& array, const T& value )
+{
+	T* out = assumeAligned<Alloc>(array.data());
+	std::size_t n = array.size();
+	std::size_t i = 0;
+
+	for (; i + BULK_BLOCK <= n; i += BULK_BLOCK)
+	{
+		T* block = out + i;
+		for (std::size_t j = 0; j < BULK_BLOCK; j++)
+			block[j] = value;
+	}
+	for (T* tail = out + i; tail != out + n; ++tail)
+		*tail = value;
+}
+
+/*** copy ***/
+template <typename T, typename AllocSrc, typename AllocDst>
+void	bulkCopy( const Array<T, AllocSrc>& src, Array<T, AllocDst>& dst )
+{
+	checkSameSize(src.size(), dst.size());
+	if (src.size() == 0)
+		return;
+
+	const T* in = assumeAligned<AllocSrc>(src.data());
+	T* out = assumeAligned<AllocDst>(dst.data());
+	std::size_t n = src.size();
+
+	if (IsTriviallyCopyable<T>::value)
+	{
+		std::memmove(out, in, n * sizeof(T));
+		return;
+	}
+	for (std::size_t i = 0; i < n; i++)
+		out[i] = in[i];
+}
+
+/*** transform ***/
+template <typename T, typename AllocSrc, typename U, typename AllocDst, typename Op>
+void	bulkTransform( const Array<T, AllocSrc>& src, Array<U, AllocDst>& dst, Op op )
+{
+	checkSameSize(src.size(), dst.size());
+
+	const T* in = assumeAligned<AllocSrc>(src.data());
+	U* out = assumeAligned<AllocDst>(dst.data());
+	std::size_t n = src.size();
+	std::size_t i = 0;
+
+	/* results go through a local block first: src and dst may overlap, the block cannot */
+	for (; i + BULK_BLOCK <= n; i += BULK_BLOCK)
+	{
+		U results[BULK_BLOCK];
+#pragma GCC unroll 16
+		for (std::size_t j = 0; j < BULK_BLOCK; j++)
+			results[j] = op(in[i + j]);
+#pragma GCC unroll 16
+		for (std::size_t j = 0; j < BULK_BLOCK; j++)
+			out[i + j] = results[j];
+	}
+	for (const T* tail = in + i; tail != in + n; ++tail)
+		out[tail - in] = op(*tail);
+}
+
+/*** reduce ***/
+/*
+**	The first block seeds BULK_BLOCK independent partial results, each later
+**	block is folded lane by lane (no dependency between lanes, so one packed
+**	instruction per group of lanes), then the lanes and the tail are folded into init
+*/
+template <typename T, typename Alloc, typename Op>
+T	bulkReduce( const Array<T, Alloc>& array, T init, Op op )
+{
+	const T* in = assumeAligned<Alloc>(array.data());
+	std::size_t n = array.size();
+	std::size_t i = 0;
+
+	if (n >= BULK_BLOCK)
+	{
+		T lanes[BULK_BLOCK];
+
+		for (std::size_t j = 0; j < BULK_BLOCK; j++)
+			lanes[j] = in[j];
+		for (i = BULK_BLOCK; i + BULK_BLOCK <= n; i += BULK_BLOCK)
+		{
+			const T* block = in + i;
+			/* fully unrolled, the lanes stay in registers across blocks */
+#pragma GCC unroll 16
+			for (std::size_t j = 0; j < BULK_BLOCK; j++)
+				lanes[j] = op(lanes[j], block[j]);
+		}
+		for (std::size_t j = 0; j < BULK_BLOCK; j++)
+			init = op(init, lanes[j]);
+	}
+	for (const T* tail = in + i; tail != in + n; ++tail)
+		init = op(init, *tail);
+	return init;
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef ARRAYVIEW_HPP
+#define ARRAYVIEW_HPP
+
+#include "Array.hpp"
+
+/*
+**	Non-owning window over contiguous elements (an Array or a part of one):
+**	two words, copied by value, never allocates. slice() narrows it further.
+**	ArrayView<const T> is the read-only form; a view of T converts to it.
+**	The viewed storage must outlive the view and keep its size: resizing or
+**	destroying the Array leaves the view dangling.
+*/
+template <typename T>
+class ArrayView
+{
+public:
+	typedef T*	iterator;
+
+	/*** constructor ***/
+	ArrayView();
+	/*** parameterized constructor ***/
+	ArrayView( T* elements, unsigned int size );
+	template <typename U, typename Alloc>
+	ArrayView( Array<U, Alloc>& array );
+	template <typename U, typename Alloc>
+	ArrayView( const Array<U, Alloc>& array );
+	template <typename U>
+	ArrayView( const ArrayView<U>& other );
+	/*** copy constructor ***/
+	ArrayView( const ArrayView& other );
+	/*** assignment operator ***/
+	ArrayView& operator=( const ArrayView& other );
+	/*** destructor ***/
+	~ArrayView();
+
+	/*** getter ***/
+	unsigned int	size( void ) const;
+	bool			empty( void ) const;
+
+	/*** element access: the view is a handle, constness comes from T ***/
+	T&			operator[]( unsigned int index ) const;
+	T&			unchecked( unsigned int index ) const;
+	T*			data( void ) const;
+	iterator	begin( void ) const;
+	iterator	end( void ) const;
+
+	/*** sub-view of length elements from offset: throws std::out_of_range if it does not fit ***/
+	ArrayView	slice( unsigned int offset, unsigned int length ) const;
+
+
+private:
+	T*				_elements;
+	unsigned int	_size;
+};
+
+/* Include the implementation file */
+#include "ArrayView.tpp"
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef ARRAYVIEW_TPP
+#define ARRAYVIEW_TPP
+
+#include "ArrayView.hpp"
+
+/*** constructor ***/
+template <typename T>
+ArrayView<T>::ArrayView() : _elements(NULL), _size(0) {}
+
+/*** parameterized constructor ***/
+template <typename T>
+ArrayView<T>::ArrayView( T* elements, unsigned int size ) : _elements(elements), _size(size) {}
+
+template <typename T>
+template <typename U, typename Alloc>
+ArrayView<T>::ArrayView( Array<U, Alloc>& array ) : _elements(array.data()), _size(array.size()) {}
+
+/* Only compiles for ArrayView<const U>: a const Array gives a const pointer */
+template <typename T>
+template <typename U, typename Alloc>
+ArrayView<T>::ArrayView( const Array<U, Alloc>& array ) : _elements(array.data()), _size(array.size()) {}
+
+template <typename T>
+template <typename U>
+ArrayView<T>::ArrayView( const ArrayView<U>& other ) : _elements(other.data()), _size(other.size()) {}
+
+/*** copy constructor ***/
+template <typename T>
+ArrayView<T>::ArrayView( const ArrayView& other ) : _elements(other._elements), _size(other._size) {}
+
+/*** assignment operator ***/
+template <typename T>
+ArrayView<T>& ArrayView<T>::operator=( const ArrayView& other )
+{
+	_elements = other._elements;
+	_size = other._size;
+	return *this;
+}
+
+/*** destructor ***/
+template <typename T>
+ArrayView<T>::~ArrayView() {}
+
+/*** getter ***/
+template <typename T>
+unsigned int	ArrayView<T>::size( void ) const { return _size; }
+
+template <typename T>
+bool	ArrayView<T>::empty( void ) const { return _size == 0; }
+
+/*** element access ***/
+template <typename T>
+T& ArrayView<T>::operator[]( unsigned int index ) const
+{
+	if (index >= _size)
+		throw std::out_of_range("Index out of range");
+	return _elements[index];
+}
+
+template <typename T>
+T& ArrayView<T>::unchecked( unsigned int index ) const { return _elements[index]; }
+
+template <typename T>
+T* ArrayView<T>::data( void ) const { return _elements; }
+
+template <typename T>
+typename ArrayView<T>::iterator ArrayView<T>::begin( void ) const { return _elements; }
+
+template <typename T>
+typename ArrayView<T>::iterator ArrayView<T>::end( void ) const { return _elements + _size; }
+
+/*** slice ***/
+template <typename T>
+ArrayView<T>	ArrayView<T>::slice( unsigned int offset, unsigned int length ) const
+{
+	if (offset > _size || length > _size - offset)
+		throw std::out_of_range("Slice out of range");
+	return ArrayView(_elements + offset, length);
+}
+
+#endif
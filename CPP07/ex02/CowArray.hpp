@@ -0,0 +1,78 @@
+#ifndef COWARRAY_HPP
+#define COWARRAY_HPP
+
+#include "Array.hpp"
+
+/*
+**	Copy-on-write Array: copies share one reference-counted buffer, so
+**	copying is O(1) however large the array; the first write through a copy
+**	whose buffer is shared duplicates it (one Array copy, memcpy for trivial
+**	types). Reads through a const CowArray never copy, so read through
+**	const references when possible.
+**
+**	Handing out a non-const reference, pointer or iterator marks the buffer
+**	unshareable: later copies are deep, so writes through that reference can
+**	never show up in another CowArray. The reference count is atomic, so
+**	copies may be read and written from different threads; one CowArray
+**	object still needs external locking like any container.
+*/
+template <typename T, typename Alloc = AlignedAllocator<T> >
+class CowArray
+{
+public:
+	typedef T*			iterator;
+	typedef const T*	const_iterator;
+
+	/*** constructor ***/
+	CowArray();
+	/*** parameterized constructor ***/
+	CowArray( unsigned int n, const Alloc& alloc = Alloc() );
+	explicit CowArray( const Array<T, Alloc>& array );
+	/*** copy constructor ***/
+	CowArray( const CowArray& other );
+	/*** assignment operator ***/
+	CowArray& operator=( const CowArray& other );
+	/*** destructor ***/
+	~CowArray();
+
+	/*** getter ***/
+	unsigned int	size( void ) const;
+	/* true while another CowArray uses the same buffer */
+	bool			shared( void ) const;
+
+	/*** reads: never copy ***/
+	const T& operator[]( unsigned int index ) const;
+	const T& unchecked( unsigned int index ) const;
+	const T* data( void ) const;
+	const_iterator begin( void ) const;
+	const_iterator end( void ) const;
+
+	/*** writes: copy the buffer first if it is shared ***/
+	T& operator[]( unsigned int index );
+	T& unchecked( unsigned int index );
+	T* data( void );
+	iterator begin( void );
+	iterator end( void );
+
+
+private:
+	struct Buffer
+	{
+		Array<T, Alloc>			array;
+		volatile unsigned long	refs;
+		bool					shareable;
+
+		Buffer( const Array<T, Alloc>& elements ) : array(elements), refs(1), shareable(true) {}
+	};
+
+	Buffer*	_buffer;
+
+	static Buffer*	share( Buffer* buffer );
+	static void		release( Buffer* buffer );
+	void			detach( void );
+};
+
+/* Include the implementation file */
+#include "CowArray.tpp"
+
+#endif
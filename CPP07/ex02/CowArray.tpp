@@ -0,0 +1,138 @@
+#ifndef COWARRAY_TPP
+#define COWARRAY_TPP
+
+#include "CowArray.hpp"
+
+/*** constructor ***/
+template <typename T, typename Alloc>
+CowArray<T, Alloc>::CowArray() : _buffer(new Buffer(Array<T, Alloc>())) {}
+
+/*** parameterized constructor ***/
+template <typename T, typename Alloc>
+CowArray<T, Alloc>::CowArray( unsigned int n, const Alloc& alloc ) : _buffer(new Buffer(Array<T, Alloc>(n, alloc))) {}
+
+template <typename T, typename Alloc>
+CowArray<T, Alloc>::CowArray( const Array<T, Alloc>& array ) : _buffer(new Buffer(array)) {}
+
+/*** copy constructor ***/
+template <typename T, typename Alloc>
+CowArray<T, Alloc>::CowArray( const CowArray& other ) : _buffer(share(other._buffer)) {}
+
+/*** assignment operator ***/
+template <typename T, typename Alloc>
+CowArray<T, Alloc>& CowArray<T, Alloc>::operator=( const CowArray& other )
+{
+	if (this != &other)
+	{
+		Buffer* buffer = share(other._buffer);
+		release(_buffer);
+		_buffer = buffer;
+	}
+	return *this;
+}
+
+/*** destructor ***/
+template <typename T, typename Alloc>
+CowArray<T, Alloc>::~CowArray() { release(_buffer); }
+
+/*** getter ***/
+template <typename T, typename Alloc>
+unsigned int	CowArray<T, Alloc>::size( void ) const { return _buffer->array.size(); }
+
+template <typename T, typename Alloc>
+bool	CowArray<T, Alloc>::shared( void ) const { return _buffer->refs > 1; }
+
+/*** reads ***/
+template <typename T, typename Alloc>
+const T& CowArray<T, Alloc>::operator[]( unsigned int index ) const
+{
+	const Array<T, Alloc>& array = _buffer->array;
+	return array[index];
+}
+
+template <typename T, typename Alloc>
+const T& CowArray<T, Alloc>::unchecked( unsigned int index ) const
+{
+	const Array<T, Alloc>& array = _buffer->array;
+	return array.unchecked(index);
+}
+
+template <typename T, typename Alloc>
+const T* CowArray<T, Alloc>::data( void ) const
+{
+	const Array<T, Alloc>& array = _buffer->array;
+	return array.data();
+}
+
+template <typename T, typename Alloc>
+typename CowArray<T, Alloc>::const_iterator CowArray<T, Alloc>::begin( void ) const { return data(); }
+
+template <typename T, typename Alloc>
+typename CowArray<T, Alloc>::const_iterator CowArray<T, Alloc>::end( void ) const { return data() + size(); }
+
+/*** writes ***/
+/*
+**	The range check happens before detach, so an out-of-range write
+**	throws without copying the buffer
+*/
+template <typename T, typename Alloc>
+T& CowArray<T, Alloc>::operator[]( unsigned int index )
+{
+	if (index >= size())
+		throw std::out_of_range("Index out of range");
+	detach();
+	return _buffer->array.unchecked(index);
+}
+
+template <typename T, typename Alloc>
+T& CowArray<T, Alloc>::unchecked( unsigned int index )
+{
+	detach();
+	return _buffer->array.unchecked(index);
+}
+
+template <typename T, typename Alloc>
+T* CowArray<T, Alloc>::data( void )
+{
+	detach();
+	return _buffer->array.data();
+}
+
+template <typename T, typename Alloc>
+typename CowArray<T, Alloc>::iterator CowArray<T, Alloc>::begin( void ) { return data(); }
+
+template <typename T, typename Alloc>
+typename CowArray<T, Alloc>::iterator CowArray<T, Alloc>::end( void ) { return data() + size(); }
+
+/*** buffer management ***/
+/* An unshareable buffer is copied instead of shared (a reference into it may be live) */
+template <typename T, typename Alloc>
+typename CowArray<T, Alloc>::Buffer*	CowArray<T, Alloc>::share( Buffer* buffer )
+{
+	if (!buffer->shareable)
+		return new Buffer(buffer->array);
+	__sync_add_and_fetch(&buffer->refs, 1);
+	return buffer;
+}
+
+template <typename T, typename Alloc>
+void	CowArray<T, Alloc>::release( Buffer* buffer )
+{
+	if (__sync_sub_and_fetch(&buffer->refs, 1) == 0)
+		delete buffer;
+}
+
+/* Gives this CowArray its own buffer, then marks it unshareable before a mutable access escapes */
+template <typename T, typename Alloc>
+void	CowArray<T, Alloc>::detach( void )
+{
+	if (_buffer->refs > 1)
+	{
+		Buffer* buffer = new Buffer(_buffer->array);
+		release(_buffer);
+		_buffer = buffer;
+	}
+	_buffer->shareable = false;
+}
+
+#endif
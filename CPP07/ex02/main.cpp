@@ -1,5 +1,12 @@
 #include <iostream>
+#include <string>
+#include <ctime>
 #include "Array.hpp"
+#include "ArrayOps.hpp"
+#include "CowArray.hpp"
+#include "ArrayView.hpp"
+#include <memory>
+#include <functional>
 
 #define SEPARATOR std::cout << "-----------------------------" << std::endl;
 
@@ -16,6 +23,348 @@ std::ostream& operator<<(std::ostream& os, const Point& p)
 	return os;
 }
 
+/*
+**	The previous implementation (new T[n], element-wise copies), kept as the
+**	benchmark baseline
+*/
+template <typename T>
+class LegacyArray
+{
+public:
+	LegacyArray( unsigned int n ) : _elements(new T[n]), _size(n) {}
+	LegacyArray( const LegacyArray& other ) : _elements(new T[other._size]), _size(other._size)
+	{
+		for (unsigned int i = 0; i < _size; i++)
+			_elements[i] = other._elements[i];
+	}
+	~LegacyArray() { delete[] _elements; }
+
+	unsigned int size( void ) const { return _size; }
+	T& operator[]( unsigned int index )
+	{
+		if (index >= _size)
+			throw std::out_of_range("Index out of range");
+		return _elements[index];
+	}
+
+private:
+	LegacyArray& operator=( const LegacyArray& );
+
+	T*				_elements;
+	unsigned int	_size;
+};
+
+static double nowMs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void printRow(const char* operation, double legacyMs, double arrayMs)
+{
+	std::cout << "  " << operation << ": legacy " << legacyMs << " ms, Array " << arrayMs
+		<< " ms (" << legacyMs / arrayMs << "x)" << std::endl;
+}
+
+/* Timed runs per measurement; the fastest one is reported */
+static const int BENCH_RUNS = 5;
+
+/*
+**	Runs op(0) .. op(repeats - 1) once untimed, so the arrays and the
+**	allocator are warm, then BENCH_RUNS times: the best run is the one least
+**	disturbed by the scheduler and by whatever ran before
+*/
+template <typename Op>
+static double bestMs(Op& op, int repeats)
+{
+	double best = 0.0;
+
+	for (int r = 0; r < repeats; r++)
+		op(r);
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		double start = nowMs();
+		for (int r = 0; r < repeats; r++)
+			op(r);
+		double elapsed = nowMs() - start;
+		if (run == 0 || elapsed < best)
+			best = elapsed;
+	}
+	return best;
+}
+
+/* Builds a Container of n elements and writes one */
+template <typename Container, typename T>
+struct ConstructOp
+{
+	unsigned int	n;
+	T				value;
+
+	ConstructOp( unsigned int size, const T& v ) : n(size), value(v) {}
+	void operator()( int )
+	{
+		Container array(n);
+		array[0] = value;
+	}
+};
+
+/* Copies a filled Container and writes one element back into the source */
+template <typename Container, typename T>
+struct CopyOp
+{
+	Container	source;
+
+	CopyOp( unsigned int n, const T& value ) : source(n)
+	{
+		for (unsigned int i = 0; i < n; i++)
+			source[i] = value;
+	}
+	void operator()( int r )
+	{
+		Container copy(source);
+		source[r % source.size()] = copy[(r + 1) % source.size()];
+	}
+};
+
+/*
+**	Each operation is repeated on an array small enough to be reused from the
+**	allocator and the caches, so the timings show the per-element work rather
+**	than first-touch page faults. Every measurement owns its arrays.
+*/
+template <typename T>
+static void benchmarkType(const char* name, unsigned int n, int repeats, const T& value)
+{
+	std::cout << name << ": best of " << BENCH_RUNS << " x " << repeats << " x " << n << " elements" << std::endl;
+
+	double legacyMs;
+	{
+		ConstructOp<LegacyArray<T>, T> op(n, value);
+		legacyMs = bestMs(op, repeats);
+	}
+	{
+		ConstructOp<Array<T>, T> op(n, value);
+		printRow("construct", legacyMs, bestMs(op, repeats));
+	}
+	{
+		CopyOp<LegacyArray<T>, T> op(n, value);
+		legacyMs = bestMs(op, repeats);
+	}
+	{
+		CopyOp<Array<T>, T> op(n, value);
+		printRow("copy     ", legacyMs, bestMs(op, repeats));
+	}
+}
+
+/* Sum of a filled LegacyArray through its checked operator[] */
+struct LegacySumOp
+{
+	LegacyArray<int>	array;
+	long long			sum;
+
+	LegacySumOp( unsigned int n ) : array(n), sum(0)
+	{
+		for (unsigned int i = 0; i < n; i++)
+			array[i] = static_cast<int>(i % 1000);
+	}
+	void operator()( int )
+	{
+		for (unsigned int i = 0; i < array.size(); i++)
+			sum += array[i];
+	}
+};
+
+/* Sum of a filled Array through the unchecked iterator pair */
+struct ArraySumOp
+{
+	Array<int>	array;
+	long long	sum;
+
+	ArraySumOp( unsigned int n ) : array(n), sum(0)
+	{
+		for (unsigned int i = 0; i < n; i++)
+			array[i] = static_cast<int>(i % 1000);
+	}
+	void operator()( int )
+	{
+		for (Array<int>::const_iterator it = array.begin(); it != array.end(); ++it)
+			sum += *it;
+	}
+};
+
+/* Sum through the checked operator[] against the unchecked iterator pair */
+static void benchmarkAccess(unsigned int n, int repeats)
+{
+	LegacySumOp legacy(n);
+	ArraySumOp array(n);
+
+	std::cout << "int sum: best of " << BENCH_RUNS << " x " << repeats << " x " << n << " elements" << std::endl;
+	double legacyMs = bestMs(legacy, repeats);
+	printRow("sum      ", legacyMs, bestMs(array, repeats));
+	std::cout << "  sums " << (legacy.sum == array.sum ? "match" : "DIFFER") << std::endl;
+}
+
+/* A bump arena: allocations are carved from one buffer and released together */
+class Arena
+{
+public:
+	Arena( std::size_t bytes ) : _buffer(static_cast<char*>(::operator new(bytes))), _size(bytes), _used(0) {}
+	~Arena() { ::operator delete(_buffer); }
+
+	void* take( std::size_t bytes )
+	{
+		std::size_t start = (_used + 63) / 64 * 64;
+		if (start + bytes > _size)
+			throw std::bad_alloc();
+		_used = start + bytes;
+		return _buffer + start;
+	}
+	std::size_t used( void ) const { return _used; }
+
+private:
+	Arena( const Arena& );
+	Arena& operator=( const Arena& );
+
+	char*		_buffer;
+	std::size_t	_size;
+	std::size_t	_used;
+};
+
+/* Allocator handing out Arena memory: deallocate is a no-op */
+template <typename T>
+struct ArenaAllocator
+{
+	typedef T value_type;
+
+	Arena* arena;
+
+	ArenaAllocator( Arena& source ) : arena(&source) {}
+	T* allocate( std::size_t n ) { return static_cast<T*>(arena->take(n * sizeof(T))); }
+	void deallocate( T*, std::size_t ) {}
+};
+
+struct ScaleAndShift
+{
+	float operator()( float x ) const { return x * 2.0f + 1.0f; }
+};
+
+static void printBulkRow(const char* operation, double plainMs, double bulkMs)
+{
+	std::cout << "  " << operation << ": plain loop " << plainMs << " ms, bulk " << bulkMs
+		<< " ms (" << plainMs / bulkMs << "x)" << std::endl;
+}
+
+/*
+**	Plain index loops over a std::allocator Array against the bulk operations
+**	over an aligned one; 64 KiB of floats so the loops are compute-bound
+*/
+static void benchmarkBulk(unsigned int n, int repeats)
+{
+	Array<float, std::allocator<float> > plain(n);
+	Array<float, std::allocator<float> > plainOut(n);
+	Array<float> aligned(n);
+	Array<float> alignedOut(n);
+	double plainTotal = 0.0;
+	double bulkTotal = 0.0;
+	double start;
+
+	std::cout << "float: " << repeats << " x " << n << " elements" << std::endl;
+
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		for (unsigned int i = 0; i < plain.size(); i++)
+			plain.unchecked(i) = static_cast<float>(r & 7);
+	double plainMs = nowMs() - start;
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		bulkFill(aligned, static_cast<float>(r & 7));
+	printBulkRow("fill     ", plainMs, nowMs() - start);
+
+	ScaleAndShift scale;
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		for (unsigned int i = 0; i < plain.size(); i++)
+			plainOut.unchecked(i) = scale(plain.unchecked(i));
+	plainMs = nowMs() - start;
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		bulkTransform(aligned, alignedOut, scale);
+	printBulkRow("transform", plainMs, nowMs() - start);
+
+	/* one float sum per pass (exact here: small integers), totals in double */
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+	{
+		float sum = 0.0f;
+		for (unsigned int i = 0; i < plainOut.size(); i++)
+			sum += plainOut.unchecked(i);
+		plainTotal += sum;
+	}
+	plainMs = nowMs() - start;
+	start = nowMs();
+	for (int r = 0; r < repeats; r++)
+		bulkTotal += bulkReduce(alignedOut, 0.0f, std::plus<float>());
+	printBulkRow("reduce   ", plainMs, nowMs() - start);
+	std::cout << "  totals " << (plainTotal == bulkTotal ? "match" : "DIFFER") << std::endl;
+}
+
+static void printCowRow(const char* operation, double arrayMs, double cowMs)
+{
+	std::cout << "  " << operation << ": Array " << arrayMs << " ms, CowArray " << cowMs
+		<< " ms (" << arrayMs / cowMs << "x)" << std::endl;
+}
+
+/*
+**	Copies that are only read (the common case for pass-by-value) and copies
+**	that write once: the first cost a deep copy each with Array, a refcount
+**	bump with CowArray; the second pay the deep copy either way
+*/
+static void benchmarkCow(unsigned int n, int copies)
+{
+	Array<int> array(n);
+	bulkFill(array, 1);
+	CowArray<int> cow(array);
+	long arraySum = 0;
+	long cowSum = 0;
+	double start;
+
+	std::cout << "int: " << copies << " copies of " << n << " elements" << std::endl;
+
+	start = nowMs();
+	for (int c = 0; c < copies; c++)
+	{
+		const Array<int> copy(array);
+		arraySum += copy[c % n];
+	}
+	double arrayMs = nowMs() - start;
+	start = nowMs();
+	for (int c = 0; c < copies; c++)
+	{
+		const CowArray<int> copy(cow);
+		cowSum += copy[c % n];
+	}
+	printCowRow("copy + read ", arrayMs, nowMs() - start);
+
+	start = nowMs();
+	for (int c = 0; c < copies; c++)
+	{
+		Array<int> copy(array);
+		copy[c % n] = c;
+		arraySum += copy[c % n];
+	}
+	arrayMs = nowMs() - start;
+	start = nowMs();
+	for (int c = 0; c < copies; c++)
+	{
+		CowArray<int> copy(cow);
+		copy[c % n] = c;
+		cowSum += copy[c % n];
+	}
+	printCowRow("copy + write", arrayMs, nowMs() - start);
+	std::cout << "  sums " << (arraySum == cowSum ? "match" : "DIFFER") << std::endl;
+}
+
 int main()
 {
 	// Test 1: Creating an empty array
@@ -122,6 +471,127 @@ int main()
 	for (unsigned int i = 0; i < pointArray.size(); ++i)
 		std::cout << "pointArray[" << i << "] = " << pointArray[i] << std::endl;
 
+	// Test 11: Unchecked access and iterators
+	SEPARATOR
+	std::cout << "Test 11: Unchecked access and iterators" << std::endl;
+	long sum = 0;
+	for (unsigned int i = 0; i < intArray.size(); ++i)
+		sum += intArray.unchecked(i);
+	std::cout << "Sum through unchecked(): " << sum << std::endl;
+	std::cout << "Through iterators: ";
+	for (Array<int>::const_iterator it = intArray.begin(); it != intArray.end(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl;
+
+	// Test 12: Resizing keeps the existing elements
+	SEPARATOR
+	std::cout << "Test 12: Resizing keeps the existing elements" << std::endl;
+	stringArray.resize(5);
+	stringArray[3] = "grown";
+	stringArray[4] = "again";
+	for (unsigned int i = 0; i < stringArray.size(); ++i)
+		std::cout << "stringArray[" << i << "] = " << stringArray[i] << std::endl;
+	pointArray.resize(2);
+	std::cout << "pointArray shrunk to " << pointArray.size() << ", last " << pointArray[1] << std::endl;
+
+	// Test 13: Benchmark against the previous implementation
+	SEPARATOR
+	std::cout << "Test 13: Benchmark against the previous implementation" << std::endl;
+	benchmarkType<int>("int", 1000000, 200, 42);
+	benchmarkType<Point>("Point", 1000000, 200, Point(1, 2));
+	benchmarkType<std::string>("std::string", 100000, 20, "a string long enough to live on the heap");
+	benchmarkAccess(1000000, 200);
+
+	// Test 14: Allocators and bulk operations
+	SEPARATOR
+	std::cout << "Test 14: Allocators and bulk operations" << std::endl;
+	Array<double> small(100);
+	Array<double, AlignedAllocator<double, 64, true> > large(1 << 20);
+	std::cout << "Default allocator, 100 doubles: 64-byte aligned: "
+		<< (reinterpret_cast<std::size_t>(small.data()) % 64 == 0 ? "yes" : "no") << std::endl;
+	std::cout << "Huge-page allocator, 8 MiB of doubles: on a 2 MiB huge-page boundary: "
+		<< (reinterpret_cast<std::size_t>(large.data()) % (2 * 1024 * 1024) == 0 ? "yes" : "no") << std::endl;
+	bulkFill(large, 0.5);
+	std::cout << "bulkReduce of 2^20 x 0.5: " << bulkReduce(large, 0.0, std::plus<double>()) << std::endl;
+	large.resize(3);
+	std::cout << "Resized below the huge-page threshold: " << large.size() << " elements, "
+		<< large[0] << " " << large[1] << " " << large[2] << std::endl;
+
+	Arena arena(1 << 16);
+	ArenaAllocator<int> fromArena(arena);
+	Array<int, ArenaAllocator<int> > first(10, fromArena);
+	Array<int, ArenaAllocator<int> > second(first);
+	bulkFill(first, 7);
+	bulkCopy(first, second);
+	std::cout << "Two arena arrays of 10 ints: arena used " << arena.used() << " bytes, second[9] = "
+		<< second[9] << std::endl;
+	try
+	{
+		Array<int> mismatch(3);
+		bulkCopy(first, mismatch);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Exception caught: " << e.what() << std::endl;
+	}
+	benchmarkBulk(16384, 20000);
+
+	// Test 15: Copy-on-write arrays
+	SEPARATOR
+	std::cout << "Test 15: Copy-on-write arrays" << std::endl;
+	CowArray<std::string> words(3);
+	words[0] = "shared";
+	words[1] = "until";
+	words[2] = "written";
+	CowArray<std::string> wordsCopy(words);
+	std::cout << "After writing through words, the copy gets its own buffer: shared = "
+		<< (wordsCopy.shared() ? "yes" : "no") << std::endl;
+	CowArray<std::string> reader(wordsCopy);
+	const CowArray<std::string>& readOnly = reader;
+	std::cout << "Copy of an untouched copy: shared = " << (reader.shared() ? "yes" : "no")
+		<< ", const read \"" << readOnly[1] << "\" keeps it shared: " << (reader.shared() ? "yes" : "no") << std::endl;
+	reader[1] = "after";
+	std::cout << "Write through reader: reader[1] = " << readOnly[1] << ", wordsCopy[1] = "
+		<< static_cast<const CowArray<std::string>&>(wordsCopy)[1] << ", shared = "
+		<< (reader.shared() ? "yes" : "no") << std::endl;
+	try
+	{
+		reader[3] = "out of range";
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Exception caught: " << e.what() << std::endl;
+	}
+	benchmarkCow(1000000, 200);
+
+	// Test 16: Slice views
+	SEPARATOR
+	std::cout << "Test 16: Slice views" << std::endl;
+	Array<int> numbers(10);
+	for (unsigned int i = 0; i < numbers.size(); i++)
+		numbers[i] = i;
+	ArrayView<int> middle = ArrayView<int>(numbers).slice(2, 6);
+	ArrayView<int> inner = middle.slice(1, 3);
+	for (ArrayView<int>::iterator it = inner.begin(); it != inner.end(); ++it)
+		*it *= 10;
+	ArrayView<const int> readView(middle);
+	std::cout << "slice(2, 6).slice(1, 3) scaled by 10, seen through the outer view:";
+	for (unsigned int i = 0; i < readView.size(); i++)
+		std::cout << " " << readView[i];
+	std::cout << std::endl << "numbers[4] = " << numbers[4] << std::endl;
+	const Array<int>& constNumbers = numbers;
+	ArrayView<const int> whole(constNumbers);
+	std::cout << "Const view of the whole array: " << whole.size() << " elements, empty slice at the end: "
+		<< (whole.slice(whole.size(), 0).empty() ? "yes" : "no") << std::endl;
+	try
+	{
+		middle.slice(4, 3);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Exception caught: " << e.what() << std::endl;
+	}
+
 	SEPARATOR
 	return 0;
 }
@@ -0,0 +1,90 @@
+#ifndef EASYFINDINDEX_HPP
+#define EASYFINDINDEX_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+/* Iterator type handed out for T: const_iterator when T is const */
+template <typename T>
+struct IteratorOf { typedef typename T::iterator type; };
+
+template <typename T>
+struct IteratorOf<const T> { typedef typename T::const_iterator type; };
+
+/**
+ * EasyfindIndex: answers many easyfind queries against the same container
+ *
+ * Built once in O(n log n), then each key costs O(1) or O(log n) instead of
+ * an O(n) scan. Like easyfind, a key maps to its first occurrence. Two
+ * layouts, chosen from the key range as PmergeMe chooses its duplicate check:
+ * - range of at most 2n values: a direct table, slot key - min holds the position
+ * - otherwise: (key, position) pairs sorted by key, searched with lower_bound
+ *
+ * The index records the container size: once it changed, lookups throw
+ * std::logic_error until rebuild() is called. Changes that keep the size
+ * (assignments through iterators) are not detected.
+ */
+template <typename T>
+class EasyfindIndex {
+public:
+	typedef typename IteratorOf<T>::type iterator;
+	typedef std::size_t size_type;
+
+	/* Position reported for a missing key */
+	static const size_type npos = static_cast<size_type>(-1);
+
+	/*** Orthodox Canonical Form ***/
+	explicit EasyfindIndex(T& container);
+	EasyfindIndex(const EasyfindIndex& other);
+	EasyfindIndex& operator=(const EasyfindIndex& other);
+	~EasyfindIndex();
+
+	/* true while the container has the size the index was built for */
+	bool valid() const;
+	void rebuild();
+
+	/* Single keys: npos / end() on a miss */
+	size_type position(int key) const;
+	iterator find(int key) const;
+
+	/* Batches: out[i] answers keys[i] */
+	void positions(const std::vector<int>& keys, std::vector<size_type>& out) const;
+	void find(const std::vector<int>& keys, std::vector<iterator>& out) const;
+
+private:
+	struct Entry {
+		int key;
+		size_type position;
+
+		bool operator<(const Entry& other) const {
+			return key < other.key || (key == other.key && position < other.position);
+		}
+	};
+
+	T* _container;
+	size_type _size;
+	/* Direct table layout */
+	bool _direct;
+	long long _min;
+	std::vector<size_type> _slots;
+	/* Sorted layout: first occurrence of each key only */
+	std::vector<Entry> _entries;
+	/* Iterators by position, for containers without random access */
+	std::vector<iterator> _iterators;
+
+	void checkValid() const;
+	size_type lookup(int key) const;
+	void sortedPositions(const std::vector<int>& keys, std::vector<size_type>& out) const;
+	iterator iteratorAt(size_type position) const;
+
+	void storeIterators(std::random_access_iterator_tag);
+	void storeIterators(std::forward_iterator_tag);
+	iterator iteratorAt(size_type position, std::random_access_iterator_tag) const;
+	iterator iteratorAt(size_type position, std::forward_iterator_tag) const;
+};
+
+/* TPP implementation */
+#include "EasyfindIndex.tpp"
+#endif
@@ -0,0 +1,228 @@
+/* TPP function implementation */
+
+#include <algorithm>
+#include <utility>
+
+template <typename T>
+const typename EasyfindIndex<T>::size_type EasyfindIndex<T>::npos;
+
+/*** Orthodox Canonical Form ***/
+template <typename T>
+EasyfindIndex<T>::EasyfindIndex(T& container)
+	: _container(&container), _size(0), _direct(true), _min(0)
+{
+	rebuild();
+}
+
+template <typename T>
+EasyfindIndex<T>::EasyfindIndex(const EasyfindIndex& other)
+	: _container(other._container), _size(other._size), _direct(other._direct), _min(other._min),
+	_slots(other._slots), _entries(other._entries), _iterators(other._iterators) {}
+
+template <typename T>
+EasyfindIndex<T>& EasyfindIndex<T>::operator=(const EasyfindIndex& other)
+{
+	if (this != &other)
+	{
+		_container = other._container;
+		_size = other._size;
+		_direct = other._direct;
+		_min = other._min;
+		_slots = other._slots;
+		_entries = other._entries;
+		_iterators = other._iterators;
+	}
+	return *this;
+}
+
+template <typename T>
+EasyfindIndex<T>::~EasyfindIndex() {}
+
+/*** public methods ***/
+
+template <typename T>
+bool EasyfindIndex<T>::valid() const
+{
+	return _container->size() == _size;
+}
+
+/* One pass for the key range, then either the direct table or the sorted pairs */
+template <typename T>
+void EasyfindIndex<T>::rebuild()
+{
+	_size = _container->size();
+	_slots.clear();
+	_entries.clear();
+	_iterators.clear();
+	_direct = true;
+	_min = 0;
+	if (_size == 0)
+		return;
+
+	long long min = *_container->begin();
+	long long max = min;
+	for (iterator it = _container->begin(); it != _container->end(); ++it)
+	{
+		min = std::min<long long>(min, *it);
+		max = std::max<long long>(max, *it);
+	}
+
+	size_type position = 0;
+	_min = min;
+	_direct = static_cast<unsigned long long>(max - min) < 2ULL * _size;
+	if (_direct)
+	{
+		_slots.assign(static_cast<size_type>(max - min + 1), npos);
+		for (iterator it = _container->begin(); it != _container->end(); ++it, ++position)
+			if (_slots[*it - min] == npos)
+				_slots[*it - min] = position;
+	}
+	else
+	{
+		_entries.resize(_size);
+		for (iterator it = _container->begin(); it != _container->end(); ++it, ++position)
+		{
+			_entries[position].key = *it;
+			_entries[position].position = position;
+		}
+		/* sorted by (key, position): the first entry of each key is its first occurrence */
+		std::sort(_entries.begin(), _entries.end());
+		size_type kept = 0;
+		for (size_type i = 0; i < _entries.size(); ++i)
+			if (kept == 0 || _entries[kept - 1].key != _entries[i].key)
+				_entries[kept++] = _entries[i];
+		_entries.resize(kept);
+	}
+	storeIterators(typename std::iterator_traits<iterator>::iterator_category());
+}
+
+template <typename T>
+typename EasyfindIndex<T>::size_type EasyfindIndex<T>::position(int key) const
+{
+	checkValid();
+	return lookup(key);
+}
+
+template <typename T>
+typename EasyfindIndex<T>::iterator EasyfindIndex<T>::find(int key) const
+{
+	checkValid();
+	return iteratorAt(lookup(key));
+}
+
+template <typename T>
+void EasyfindIndex<T>::positions(const std::vector<int>& keys, std::vector<size_type>& out) const
+{
+	checkValid();
+	out.resize(keys.size());
+	if (!_direct)
+		sortedPositions(keys, out);
+	else
+		for (size_type i = 0; i < keys.size(); ++i)
+			out[i] = lookup(keys[i]);
+}
+
+template <typename T>
+void EasyfindIndex<T>::find(const std::vector<int>& keys, std::vector<iterator>& out) const
+{
+	std::vector<size_type> found;
+
+	positions(keys, found);
+	out.resize(keys.size());
+	for (size_type i = 0; i < keys.size(); ++i)
+		out[i] = iteratorAt(found[i]);
+}
+
+/*** private methods ***/
+
+template <typename T>
+void EasyfindIndex<T>::checkValid() const
+{
+	if (!valid())
+		throw std::logic_error("EasyfindIndex is stale: the container size changed, call rebuild()");
+}
+
+template <typename T>
+typename EasyfindIndex<T>::size_type EasyfindIndex<T>::lookup(int key) const
+{
+	if (_direct)
+	{
+		long long offset = key - _min;
+		if (offset < 0 || offset >= static_cast<long long>(_slots.size()))
+			return npos;
+		return _slots[offset];
+	}
+
+	Entry probe = { key, 0 };
+	typename std::vector<Entry>::const_iterator it = std::lower_bound(_entries.begin(), _entries.end(), probe);
+	if (it == _entries.end() || it->key != key)
+		return npos;
+	return it->position;
+}
+
+/**
+ * Large batches (k log2 n above n) are sorted and merged with the entries in
+ * a single forward pass, O(n + k log k) with sequential memory access;
+ * smaller ones do one binary search per key, O(k log n).
+ */
+template <typename T>
+void EasyfindIndex<T>::sortedPositions(const std::vector<int>& keys, std::vector<size_type>& out) const
+{
+	size_type depth = 1;
+	while ((static_cast<size_type>(1) << depth) < _entries.size())
+		++depth;
+	if (keys.size() * depth < _entries.size())
+	{
+		for (size_type i = 0; i < keys.size(); ++i)
+			out[i] = lookup(keys[i]);
+		return;
+	}
+
+	std::vector<std::pair<int, size_type> > order(keys.size());
+	for (size_type i = 0; i < keys.size(); ++i)
+		order[i] = std::make_pair(keys[i], i);
+	std::sort(order.begin(), order.end());
+
+	size_type entry = 0;
+	for (size_type i = 0; i < order.size(); ++i)
+	{
+		while (entry < _entries.size() && _entries[entry].key < order[i].first)
+			++entry;
+		if (entry < _entries.size() && _entries[entry].key == order[i].first)
+			out[order[i].second] = _entries[entry].position;
+		else
+			out[order[i].second] = npos;
+	}
+}
+
+template <typename T>
+typename EasyfindIndex<T>::iterator EasyfindIndex<T>::iteratorAt(size_type position) const
+{
+	if (position == npos)
+		return _container->end();
+	return iteratorAt(position, typename std::iterator_traits<iterator>::iterator_category());
+}
+
+/* Random access: begin() + position, nothing to store */
+template <typename T>
+void EasyfindIndex<T>::storeIterators(std::random_access_iterator_tag) {}
+
+template <typename T>
+void EasyfindIndex<T>::storeIterators(std::forward_iterator_tag)
+{
+	_iterators.reserve(_size);
+	for (iterator it = _container->begin(); it != _container->end(); ++it)
+		_iterators.push_back(it);
+}
+
+template <typename T>
+typename EasyfindIndex<T>::iterator EasyfindIndex<T>::iteratorAt(size_type position, std::random_access_iterator_tag) const
+{
+	return _container->begin() + position;
+}
+
+template <typename T>
+typename EasyfindIndex<T>::iterator EasyfindIndex<T>::iteratorAt(size_type position, std::forward_iterator_tag) const
+{
+	return _iterators[position];
+}
@@ -0,0 +1,28 @@
+#include "easyfind.hpp"
+
+/* Ints compared per step of the block scan */
+static const long SCAN_BLOCK = 16;
+
+/**
+ * Block scan: the 16 comparisons of a block are folded into one flag without
+ * branching, which GCC turns into packed compares (-O2). target_clones builds
+ * one version per instruction set and picks it at load time from the CPU:
+ * 16 ints per compare with AVX-512, 8 with AVX2, 4 with the baseline SSE2.
+ * Only the block holding the match is then scanned element by element.
+ */
+__attribute__((target_clones("avx512f", "avx2", "default")))
+const int* scanInts(const int* first, const int* last, int value)
+{
+	while (last - first >= SCAN_BLOCK)
+	{
+		int hits = 0;
+		for (long i = 0; i < SCAN_BLOCK; ++i)
+			hits |= (first[i] == value);
+		if (hits)
+			break;
+		first += SCAN_BLOCK;
+	}
+	while (first != last && *first != value)
+		++first;
+	return first;
+}
@@ -4,17 +4,75 @@
 #include <algorithm>
 #include <stdexcept>
 #include <iterator>
+#include <new>
+#include <vector>
+#include <set>
 
-/* Template function that finds an integer in a container of integers */
+/**
+ * easyfind: finds an integer in a container of integers
+ *
+ * The search strategy is picked from the container type (tag dispatch):
+ * - std::vector<int>: contiguous scan comparing 16 ints per step (SIMD, see scanInts)
+ * - std::set<int> / std::multiset<int>: the member find, O(log n)
+ * - any other container: std::find
+ * Passing sortedRange asks for a binary search instead (the container must be
+ * sorted in ascending order). Passing std::nothrow returns end() on a miss
+ * instead of throwing, for loops where misses are common.
+ * Every form accepts const containers and then returns a const_iterator.
+ */
+
+/* Tag asking easyfind for a binary search over an ascending container */
+struct SortedRange {};
+static const SortedRange sortedRange = SortedRange();
+
+/* Strategy tags */
+struct LinearSearch {};
+struct ContiguousSearch {};
+struct MemberSearch {};
+struct BinarySearch {};
+
+/*
+ * Strategy used for a container type when no SortedRange is given.
+ * std::vector is the only standard container C++98 guarantees to be
+ * contiguous, so it is the only one mapped to ContiguousSearch. Another
+ * container of contiguous ints (begin() dereferencing to the first int,
+ * size(), empty()) can opt in by specializing SearchStrategy.
+ */
+template <typename T>
+struct SearchStrategy { typedef LinearSearch type; };
+
+template <typename Alloc>
+struct SearchStrategy< std::vector<int, Alloc> > { typedef ContiguousSearch type; };
+
+template <typename Compare, typename Alloc>
+struct SearchStrategy< std::set<int, Compare, Alloc> > { typedef MemberSearch type; };
+
+template <typename Compare, typename Alloc>
+struct SearchStrategy< std::multiset<int, Compare, Alloc> > { typedef MemberSearch type; };
+
+/* First element of [first, last) equal to value, or last (vectorized kernel, easyfind.cpp) */
+const int* scanInts(const int* first, const int* last, int value);
+
+/* Throws std::invalid_argument when the value is missing */
+template <typename T>
+typename T::iterator easyfind(T& container, int value);
+template <typename T>
+typename T::const_iterator easyfind(const T& container, int value);
+template <typename T>
+typename T::iterator easyfind(T& container, int value, SortedRange);
+template <typename T>
+typename T::const_iterator easyfind(const T& container, int value, SortedRange);
+
+/* Returns end() when the value is missing */
+template <typename T>
+typename T::iterator easyfind(T& container, int value, const std::nothrow_t&);
+template <typename T>
+typename T::const_iterator easyfind(const T& container, int value, const std::nothrow_t&);
+template <typename T>
+typename T::iterator easyfind(T& container, int value, SortedRange, const std::nothrow_t&);
 template <typename T>
-typename T::iterator easyfind(T& container, int value)
-{
-	typename T::iterator it = std::find(container.begin(), container.end(), value);
-	
-	/* If element is not found, std::find returns end iterator, so throw an exception */
-	if (it == container.end())
-		throw std::invalid_argument("Element not found");
-	return it;
-}
+typename T::const_iterator easyfind(const T& container, int value, SortedRange, const std::nothrow_t&);
 
+/* TPP implementation */
+#include "easyfind.tpp"
 #endif
@@ -0,0 +1,97 @@
+/* TPP function implementation */
+
+/* Strategy implementations: Iterator is T::iterator or T::const_iterator, Container T or const T */
+template <typename Iterator, typename Container>
+Iterator easyfindLocate(Container& container, int value, LinearSearch)
+{
+	return std::find(container.begin(), container.end(), value);
+}
+
+/* The elements are contiguous ints: scan them as an array */
+template <typename Iterator, typename Container>
+Iterator easyfindLocate(Container& container, int value, ContiguousSearch)
+{
+	Iterator first = container.begin();
+
+	if (container.empty())
+		return first;
+	const int* data = &*first;
+	return first + (scanInts(data, data + container.size(), value) - data);
+}
+
+/* Ordered tree: the member find is O(log n) (for a multiset, any of the equal elements) */
+template <typename Iterator, typename Container>
+Iterator easyfindLocate(Container& container, int value, MemberSearch)
+{
+	return container.find(value);
+}
+
+/* Ascending container: lower_bound is O(log n) comparisons (and O(log n) steps with random access) */
+template <typename Iterator, typename Container>
+Iterator easyfindLocate(Container& container, int value, BinarySearch)
+{
+	Iterator it = std::lower_bound(container.begin(), container.end(), value);
+
+	if (it != container.end() && !(value < *it))
+		return it;
+	return container.end();
+}
+
+/* If the element is not found, easyfindLocate returns the end iterator, so throw an exception */
+template <typename Iterator>
+Iterator easyfindFound(Iterator it, Iterator end)
+{
+	if (it == end)
+		throw std::invalid_argument("Element not found");
+	return it;
+}
+
+/* Throwing forms */
+template <typename T>
+typename T::iterator easyfind(T& container, int value)
+{
+	return easyfindFound(easyfindLocate<typename T::iterator>(container, value, typename SearchStrategy<T>::type()), container.end());
+}
+
+template <typename T>
+typename T::const_iterator easyfind(const T& container, int value)
+{
+	return easyfindFound(easyfindLocate<typename T::const_iterator>(container, value, typename SearchStrategy<T>::type()), container.end());
+}
+
+template <typename T>
+typename T::iterator easyfind(T& container, int value, SortedRange)
+{
+	return easyfindFound(easyfindLocate<typename T::iterator>(container, value, BinarySearch()), container.end());
+}
+
+template <typename T>
+typename T::const_iterator easyfind(const T& container, int value, SortedRange)
+{
+	return easyfindFound(easyfindLocate<typename T::const_iterator>(container, value, BinarySearch()), container.end());
+}
+
+/* Non-throwing forms */
+template <typename T>
+typename T::iterator easyfind(T& container, int value, const std::nothrow_t&)
+{
+	return easyfindLocate<typename T::iterator>(container, value, typename SearchStrategy<T>::type());
+}
+
+template <typename T>
+typename T::const_iterator easyfind(const T& container, int value, const std::nothrow_t&)
+{
+	return easyfindLocate<typename T::const_iterator>(container, value, typename SearchStrategy<T>::type());
+}
+
+template <typename T>
+typename T::iterator easyfind(T& container, int value, SortedRange, const std::nothrow_t&)
+{
+	return easyfindLocate<typename T::iterator>(container, value, BinarySearch());
+}
+
+template <typename T>
+typename T::const_iterator easyfind(const T& container, int value, SortedRange, const std::nothrow_t&)
+{
+	return easyfindLocate<typename T::const_iterator>(container, value, BinarySearch());
+}
@@ -1,7 +1,115 @@
 #include "easyfind.hpp"
+#include "EasyfindIndex.hpp"
 #include <vector>
 #include <list>
+#include <deque>
+#include <set>
 #include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+static double nowMs()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* Prints the average ns per lookup of keys and the number of hits (which also keeps the loop from being optimized out) */
+template <typename Lookup>
+static void timeLookups(const char* name, Lookup lookup, const std::vector<int>& keys)
+{
+    long hits = 0;
+    double start = nowMs();
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        hits += lookup(keys[i]);
+    double ns = (nowMs() - start) * 1000000.0 / keys.size();
+    std::cout << "    " << name << " " << ns << " (" << hits << "/" << keys.size() << " hits)" << std::endl;
+}
+
+struct StdFind {
+    const std::vector<int>* values;
+    int operator()(int key) const { return std::find(values->begin(), values->end(), key) != values->end(); }
+};
+
+struct VectorEasyfind {
+    const std::vector<int>* values;
+    int operator()(int key) const { return easyfind(*values, key, std::nothrow) != values->end(); }
+};
+
+struct SortedEasyfind {
+    const std::vector<int>* values;
+    int operator()(int key) const { return easyfind(*values, key, sortedRange, std::nothrow) != values->end(); }
+};
+
+struct SetEasyfind {
+    const std::set<int>* values;
+    int operator()(int key) const { return easyfind(*values, key, std::nothrow) != values->end(); }
+};
+
+/* Keys uniformly drawn from [0, 2n): about half of them are misses */
+static std::vector<int> randomKeys(std::size_t count, std::size_t n)
+{
+    std::vector<int> keys(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        keys[i] = std::rand() % (2 * n);
+    return keys;
+}
+
+static void benchmark(std::size_t n)
+{
+    std::vector<int> values(n);
+    for (std::size_t i = 0; i < n; ++i)
+        values[i] = static_cast<int>(2 * i);
+    std::vector<int> shuffled(values);
+    std::random_shuffle(shuffled.begin(), shuffled.end());
+    std::set<int> tree(values.begin(), values.end());
+
+    /* the linear scans get fewer keys so each size stays around the same total work */
+    std::vector<int> scanKeys = randomKeys(std::max<std::size_t>(20, 100000000 / n), n);
+    std::vector<int> logKeys = randomKeys(1000000, n);
+
+    StdFind stdFind = { &shuffled };
+    VectorEasyfind vectorFind = { &shuffled };
+    SortedEasyfind sortedFind = { &values };
+    SetEasyfind setFind = { &tree };
+
+    std::cout << "  n = " << n << " (ns per lookup)" << std::endl;
+    timeLookups("std::find        ", stdFind, scanKeys);
+    timeLookups("easyfind (SIMD)  ", vectorFind, scanKeys);
+    timeLookups("easyfind sorted  ", sortedFind, logKeys);
+    timeLookups("easyfind std::set", setFind, logKeys);
+}
+
+/* Same keys answered by repeated easyfind calls and by one index (build included) */
+static void benchmarkIndex(const char* name, const std::vector<int>& values, const std::vector<int>& keys)
+{
+    std::size_t scanned = std::min<std::size_t>(keys.size(), 500);
+    long hits = 0;
+    double start = nowMs();
+
+    for (std::size_t i = 0; i < scanned; ++i)
+        hits += easyfind(values, keys[i], std::nothrow) != values.end();
+    double scanNs = (nowMs() - start) * 1000000.0 / scanned;
+
+    start = nowMs();
+    EasyfindIndex<const std::vector<int> > index(values);
+    double buildMs = nowMs() - start;
+    std::vector<std::size_t> positions;
+    start = nowMs();
+    index.positions(keys, positions);
+    double batchNs = (nowMs() - start) * 1000000.0 / keys.size();
+
+    long indexHits = 0;
+    for (std::size_t i = 0; i < scanned; ++i)
+        indexHits += positions[i] != EasyfindIndex<const std::vector<int> >::npos;
+    std::cout << "  " << name << ": easyfind " << scanNs << " ns/key, index build " << buildMs
+        << " ms then " << batchNs << " ns/key (" << keys.size() << " keys, "
+        << (hits == indexHits ? "same answers" : "DIFFERENT answers") << ")" << std::endl;
+}
 
 int main()
 {
@@ -43,5 +151,115 @@ int main()
         std::cerr << e.what() << std::endl;
     }
 
+    std::cout << "----------------------------" << std::endl;
+
+    try {
+        std::cout << "Strategies and const containers" << std::endl;
+        std::vector<int> values;
+        for (int i = 0; i < 100; ++i)
+            values.push_back(i * 3);
+        const std::vector<int>& constValues = values;
+
+        std::vector<int>::const_iterator scan = easyfind(constValues, 297);
+        std::cout << "Found (const vector, SIMD scan): " << *scan << " at " << scan - constValues.begin() << std::endl;
+        std::vector<int>::const_iterator binary = easyfind(constValues, 150, sortedRange);
+        std::cout << "Found (sorted vector, binary search): " << *binary << " at " << binary - constValues.begin() << std::endl;
+
+        std::set<int> tree(values.begin(), values.end());
+        std::cout << "Found (std::set, member find): " << *easyfind(tree, 42) << std::endl;
+
+        std::multiset<int> bag;
+        bag.insert(7);
+        bag.insert(7);
+        std::cout << "Found (std::multiset, member find): " << *easyfind(bag, 7) << std::endl;
+
+        std::deque<int> queue(values.begin(), values.end());
+        std::cout << "Found (std::deque, std::find): " << *easyfind(queue, 99) << std::endl;
+
+        const std::list<int> sortedList(values.begin(), values.end());
+        std::cout << "Found (sorted const list, binary search): " << *easyfind(sortedList, 33, sortedRange) << std::endl;
+
+        std::cout << "Non-throwing miss returns end(): "
+            << (easyfind(values, 1, std::nothrow) == values.end() ? "yes" : "no") << ", "
+            << (easyfind(values, 1, sortedRange, std::nothrow) == values.end() ? "yes" : "no") << ", "
+            << (easyfind(tree, 1, std::nothrow) == tree.end() ? "yes" : "no") << std::endl;
+
+        easyfind(constValues, 1, sortedRange);
+        std::cout << "Not reached" << std::endl;
+
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    std::cout << "----------------------------" << std::endl;
+
+    try {
+        std::cout << "Prebuilt index" << std::endl;
+        std::list<int> lst;
+        for (int i = 0; i < 10; ++i)
+            lst.push_back(i * 1000 % 7);
+        EasyfindIndex<std::list<int> > index(lst);
+
+        std::vector<int> keys;
+        keys.push_back(6);
+        keys.push_back(42);
+        keys.push_back(0);
+        std::vector<std::list<int>::iterator> found;
+        index.find(keys, found);
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            std::cout << "Key " << keys[i] << ": ";
+            if (found[i] == lst.end())
+                std::cout << "missing";
+            else
+                std::cout << "found " << *found[i] << " at position " << index.position(keys[i]);
+            std::cout << std::endl;
+        }
+
+        lst.push_back(42);
+        std::cout << "Index valid after push_back: " << (index.valid() ? "yes" : "no") << std::endl;
+        try {
+            index.find(42);
+        } catch (const std::logic_error& e) {
+            std::cerr << e.what() << std::endl;
+        }
+        index.rebuild();
+        std::cout << "After rebuild, key 42 at position " << index.position(42) << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    std::cout << "----------------------------" << std::endl;
+
+    std::cout << "Benchmark: repeated easyfind against a prebuilt index (1000000 values)" << std::endl;
+    {
+        std::srand(7);
+        std::vector<int> dense(1000000);
+        std::vector<int> sparse(1000000);
+        for (std::size_t i = 0; i < dense.size(); ++i)
+        {
+            dense[i] = static_cast<int>(i);
+            sparse[i] = std::rand();
+        }
+        std::random_shuffle(dense.begin(), dense.end());
+        std::vector<int> denseKeys = randomKeys(1000000, dense.size());
+        std::vector<int> sparseKeys(1000000);
+        for (std::size_t i = 0; i < sparseKeys.size(); ++i)
+            sparseKeys[i] = (i % 2) ? sparse[std::rand() % sparse.size()] : std::rand();
+        std::vector<int> fewKeys(sparseKeys.begin(), sparseKeys.begin() + 1000);
+
+        benchmarkIndex("dense keys, direct table  ", dense, denseKeys);
+        benchmarkIndex("sparse keys, sorted batch ", sparse, sparseKeys);
+        benchmarkIndex("sparse keys, small batch  ", sparse, fewKeys);
+    }
+
+    std::cout << "----------------------------" << std::endl;
+
+    std::cout << "Benchmark: about half of the keys are misses" << std::endl;
+    std::srand(42);
+    for (std::size_t n = 1000; n <= 10000000; n *= 100)
+        benchmark(n);
+
     return 0;
 }
@@ -1,14 +1,21 @@
 #include "Span.hpp"
 
 /*** parameterized constructor ***/
-Span::Span(unsigned int N) : _maxSize(N)
+Span::Span(unsigned int N)
+    : _maxSize(N), _indexed(true), _min(0), _max(0), _minGap(0), _gapValid(true),
+    _sortMethod(SORT_STD), _threads(hardwareThreads()),
+    _seed(mixSeed(static_cast<unsigned long long>(std::time(NULL)) ^ reinterpret_cast<std::size_t>(this)))
 {
     /* reserve N numbers in the container */
     _numbers.reserve(N);
 }
 
 /*** copy constructor ***/
-Span::Span(const Span& other) : _numbers(other._numbers), _maxSize(other._maxSize) {}
+Span::Span(const Span& other)
+    : _numbers(other._numbers), _maxSize(other._maxSize), _sorted(other._sorted),
+    _indexed(other._indexed), _min(other._min), _max(other._max), _minGap(other._minGap),
+    _gapValid(other._gapValid), _sortMethod(other._sortMethod), _threads(other._threads),
+    _seed(mixSeed(other._seed)) {}
 
 /*** assignment operator ***/
 Span& Span::operator=(const Span& other)
@@ -17,6 +24,15 @@ Span& Span::operator=(const Span& other)
     {
         _numbers = other._numbers;
         _maxSize = other._maxSize;
+        _sorted = other._sorted;
+        _indexed = other._indexed;
+        _min = other._min;
+        _max = other._max;
+        _minGap = other._minGap;
+        _gapValid = other._gapValid;
+        _sortMethod = other._sortMethod;
+        _threads = other._threads;
+        _seed = mixSeed(other._seed);
     }
     return *this;
 }
@@ -35,39 +51,82 @@ void Span::addNumber(int num)
         throw std::overflow_error(ss.str());
     }
     _numbers.push_back(num);
+    record(num);
 }
 
-/* Method to calculate the shortest span */
-int Span::shortestSpan() const
+/* Contiguous ints: std::vector::insert from pointers is a single memmove, no per-element push_back */
+void Span::addNumber(const int* begin, const int* end)
+{
+    std::size_t count = end - begin;
+
+    checkRoom(count);
+    if (_indexed && count < BULK_THRESHOLD) {
+        for (; begin != end; ++begin) {
+            _numbers.push_back(*begin);
+            record(*begin);
+        }
+        return;
+    }
+
+    std::size_t start = _numbers.size();
+    _numbers.insert(_numbers.end(), begin, end);
+    recordBulk(start);
+}
+
+void Span::addNumber(int* begin, int* end)
+{
+    addNumber(const_cast<const int*>(begin), const_cast<const int*>(end));
+}
+
+void Span::addNumber(std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end)
+{
+    if (begin == end)
+        return;
+
+    const int* first = &*begin;
+    addNumber(first, first + (end - begin));
+}
+
+void Span::addNumber(std::vector<int>::iterator begin, std::vector<int>::iterator end)
+{
+    addNumber(std::vector<int>::const_iterator(begin), std::vector<int>::const_iterator(end));
+}
+
+/*
+ * Method to calculate the shortest span: kept up to date by addNumber, or
+ * recomputed here once after a bulk addition (sorted copy, then min gap).
+ * The sorted copy also rebuilds the multiset, so additions after the query
+ * are incremental again; a full span takes no more numbers and skips it.
+ */
+long long Span::shortestSpan() const
 {
     if (_numbers.size() < 2) {
         throw std::logic_error("Not enough numbers to calculate a span (need at least 2)");
     }
-    
-    std::vector<int> sorted = _numbers;
-    std::sort(sorted.begin(), sorted.end());
-
-    int minSpan = sorted[1] - sorted[0];
-    for (size_t i = 1; i < sorted.size(); i++) {
-        int currentSpan = sorted[i] - sorted[i - 1];
-        if (currentSpan < minSpan) {
-            minSpan = currentSpan;
+    if (!_gapValid) {
+        std::vector<int> sorted(_numbers);
+        if (_sortMethod == SORT_RADIX)
+            radixSort(sorted, _threads);
+        else
+            standardSort(sorted, _threads);
+        _minGap = minAdjacentGap(&sorted[0], sorted.size(), _threads);
+        _gapValid = true;
+        if (!_indexed && !full()) {
+            for (std::size_t i = 0; i < sorted.size(); ++i)
+                _sorted.insert(_sorted.end(), sorted[i]);
+            _indexed = true;
         }
     }
-    return minSpan;
+    return _minGap;
 }
 
-/* Method to calculate the longest span */
-int Span::longestSpan() const
+/* Method to calculate the longest span: kept up to date by addNumber */
+long long Span::longestSpan() const
 {
     if (_numbers.size() < 2) {
         throw std::logic_error("Not enough numbers to calculate a span (need at least 2)");
     }
-    
-    int minElement = *std::min_element(_numbers.begin(), _numbers.end());
-    int maxElement = *std::max_element(_numbers.begin(), _numbers.end());
-
-    return maxElement - minElement;
+    return static_cast<long long>(_max) - _min;
 }
 
 /* Utility methods */
@@ -89,6 +148,9 @@ bool Span::full() const {
 
 void Span::clear() {
     _numbers.clear();
+    _sorted.clear();
+    _indexed = true;
+    _gapValid = true;
 }
 
 /* Access method with bounds checking */
@@ -101,16 +163,105 @@ int Span::at(unsigned int index) const {
     return _numbers[index];
 }
 
-/* Fill span with random numbers */
+/* Fill span with random numbers: each call continues from the seed the previous one advanced */
 void Span::fillRandomly(int min, int max) {
+    unsigned long long seed = _seed;
+
+    _seed = mixSeed(_seed);
+    fillRandomly(min, max, seed, _threads);
+}
+
+/* Fill span with random numbers generated from seed, block by block (see fillUniform) */
+void Span::fillRandomly(int min, int max, unsigned long long seed, unsigned int threads) {
     if (min >= max) {
         throw std::invalid_argument("Min value must be less than max value");
     }
-    
-    std::srand(static_cast<unsigned int>(std::time(NULL)));
-    while (_numbers.size() < _maxSize) {
-        _numbers.push_back(min + std::rand() % (max - min + 1));
+
+    std::size_t count = _maxSize - _numbers.size();
+    if (count == 0)
+        return;
+    if (_indexed && count < BULK_THRESHOLD) {
+        std::vector<int> added(count);
+        fillUniform(&added[0], count, min, max, seed, threads);
+        addNumber(added.begin(), added.end());
+        return;
     }
+
+    std::size_t start = _numbers.size();
+    _numbers.resize(_maxSize);
+    fillUniform(&_numbers[start], count, min, max, seed, threads);
+    recordBulk(start);
+}
+
+/* Updates min, max and the smallest gap with a number just appended to _numbers */
+void Span::record(int num) {
+    if (_numbers.size() == 1) {
+        _min = num;
+        _max = num;
+    }
+    else {
+        _min = std::min(_min, num);
+        _max = std::max(_max, num);
+    }
+
+    if (!_indexed) {
+        _gapValid = false;
+        return;
+    }
+
+    std::multiset<int>::iterator it = _sorted.insert(num);
+    std::multiset<int>::iterator next = it;
+
+    if (++next != _sorted.end()) {
+        long long gap = static_cast<long long>(*next) - num;
+        if (_sorted.size() == 2 || gap < _minGap)
+            _minGap = gap;
+    }
+    if (it != _sorted.begin()) {
+        std::multiset<int>::iterator previous = it;
+        long long gap = static_cast<long long>(num) - *--previous;
+        if (_sorted.size() == 2 || gap < _minGap)
+            _minGap = gap;
+    }
+}
+
+/* Bulk version of record: one minMax pass over the new numbers, gap recomputed on demand */
+void Span::recordBulk(std::size_t start) {
+    if (start == _numbers.size())
+        return;
+
+    int low;
+    int high;
+
+    minMax(&_numbers[start], _numbers.size() - start, low, high, _threads);
+    if (start == 0) {
+        _min = low;
+        _max = high;
+    }
+    else {
+        _min = std::min(_min, low);
+        _max = std::max(_max, high);
+    }
+    _indexed = false;
+    _sorted.clear();
+    _gapValid = false;
+}
+
+void Span::checkRoom(std::size_t count) const {
+    if (_numbers.size() + count > _maxSize) {
+        std::stringstream ss;
+        ss << "Adding these numbers will exceed the maximum size of " << _maxSize;
+        throw std::overflow_error(ss.str());
+    }
+}
+
+/* Recompute settings */
+void Span::setSortMethod(SortMethod method) {
+    _sortMethod = method;
+}
+
+void Span::setThreads(unsigned int threads) {
+    _threads = (threads > 0) ? threads : 1;
 }
 
 /* Print all numbers (for debugging) */
@@ -2,16 +2,49 @@
 #define SPAN_HPP
 
 #include <vector>
+#include <set>
 #include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
 #include <sstream>
+#include "SpanKernels.hpp"
 
+/**
+ * Span: at most N ints and the shortest / longest distance between two of them
+ *
+ * The statistics are kept up to date by addNumber instead of being computed
+ * by each query: running min and max for longestSpan, and a sorted multiset
+ * of the numbers for shortestSpan. Numbers are only ever added (clear() starts
+ * over), so the smallest gap can only shrink: a new number x is compared with
+ * its two neighbours in the multiset, found in O(log n), and the gap they had
+ * between them can be forgotten since x splits it into two smaller ones. Both
+ * queries are O(1).
+ *
+ * A batch of at least BULK_THRESHOLD numbers (range addNumber, fillRandomly)
+ * is appended as is (a single block copy when the range is contiguous ints)
+ * and drops the multiset: min and max come from one pass of
+ * the minMax kernel, and the next shortestSpan sorts a copy (std::sort or
+ * radix sort, see setSortMethod) and reduces its gaps once, keeping the
+ * result until the next addition. That sorted copy rebuilds the multiset in
+ * linear time (unless the span is full), so later additions are incremental
+ * again. The kernels use setThreads threads on spans of at least
+ * PARALLEL_THRESHOLD numbers.
+ */
 class Span
 {
 public:
+	/* how shortestSpan sorts the numbers when it has to recompute */
+	enum SortMethod
+	{
+		SORT_STD,
+		SORT_RADIX
+	};
+
+	/* batches from this size on bypass the multiset */
+	static const unsigned int BULK_THRESHOLD = 1024;
+
 	/*** parameterized constructor ***/
 	Span(unsigned int N);
 	/*** copy constructor ***/
@@ -30,19 +63,35 @@ public:
 	template <typename Iterator>
 	void addNumber(Iterator begin, Iterator end)
 	{
-		if (_numbers.size() + std::distance(begin, end) > _maxSize) {
-			std::stringstream ss;
-			ss << "Adding these numbers will exceed the maximum size of " << _maxSize;
-			throw std::overflow_error(ss.str());
+		std::size_t count = std::distance(begin, end);
+
+		checkRoom(count);
+		if (_indexed && count < BULK_THRESHOLD)
+		{
+			for (; begin != end; ++begin)
+			{
+				_numbers.push_back(*begin);
+				record(*begin);
+			}
+			return;
 		}
+
+		std::size_t start = _numbers.size();
 		_numbers.insert(_numbers.end(), begin, end);
+		recordBulk(start);
 	}
 
-	/* Method to calculate the shortest span */
-	int shortestSpan() const;
+	/* Contiguous ranges: one block copy into the reserved storage, then one minMax pass */
+	void addNumber(const int* begin, const int* end);
+	void addNumber(int* begin, int* end);
+	void addNumber(std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end);
+	void addNumber(std::vector<int>::iterator begin, std::vector<int>::iterator end);
+
+	/* Method to calculate the shortest span (64-bit: INT_MIN to INT_MAX does not overflow) */
+	long long shortestSpan() const;
 
-	/* Method to calculate the longest span */
-	int longestSpan() const;
+	/* Method to calculate the longest span (64-bit: INT_MIN to INT_MAX does not overflow) */
+	long long longestSpan() const;
 
 	/* Utility methods */
 	unsigned int size() const;
@@ -54,15 +103,42 @@ public:
 	/* Access method with bounds checking */
 	int at(unsigned int index) const;
 
-	/* Fill span with random numbers */
+	/* Fill span with random numbers in [min, max]: a new sequence on every call */
 	void fillRandomly(int min, int max);
+	/* Same, reproducible: the numbers depend on the seed only, whatever the thread count */
+	void fillRandomly(int min, int max, unsigned long long seed, unsigned int threads = 1);
 
 	/* Print all numbers (for debugging) */
 	void print() const;
 
+	/* Recompute settings */
+	void setSortMethod(SortMethod method);
+	void setThreads(unsigned int threads);
+
 private:
 	std::vector<int> _numbers;
 	unsigned int _maxSize;
+
+	/* incremental statistics, valid once there are numbers (a gap once there are two) */
+	mutable std::multiset<int> _sorted;
+	mutable bool _indexed;
+	int _min;
+	int _max;
+	mutable long long _minGap;
+	mutable bool _gapValid;
+
+	SortMethod _sortMethod;
+	unsigned int _threads;
+
+	/* seed of the next fillRandomly(min, max), advanced by every call */
+	unsigned long long _seed;
+
+	/* updates min, max and the smallest gap with a number just appended */
+	void record(int num);
+	/* same for _numbers[start, size()) appended at once, dropping the multiset */
+	void recordBulk(std::size_t start);
+	/* throws std::overflow_error if count more numbers do not fit */
+	void checkRoom(std::size_t count) const;
 };
 
 #endif
\ No newline at end of file
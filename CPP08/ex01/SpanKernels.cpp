@@ -0,0 +1,447 @@
+#include "SpanKernels.hpp"
+#include <algorithm>
+#include <pthread.h>
+#include <unistd.h>
+
+/*** threads ***/
+
+/* Work split between the threads: run() receives a slice [begin, end) */
+class KernelTask
+{
+public:
+    virtual ~KernelTask() {}
+    virtual void run(std::size_t begin, std::size_t end, unsigned int worker) = 0;
+};
+
+struct Slice
+{
+    KernelTask* task;
+    std::size_t begin;
+    std::size_t end;
+    unsigned int worker;
+};
+
+static void* runSlice(void* arg)
+{
+    Slice* slice = static_cast<Slice*>(arg);
+
+    slice->task->run(slice->begin, slice->end, slice->worker);
+    return NULL;
+}
+
+/* Splits [0, count) into `threads` slices, the calling thread takes the first one */
+static void parallelFor(std::size_t count, unsigned int threads, KernelTask& task)
+{
+    std::vector<Slice> slices(threads);
+    std::vector<pthread_t> ids(threads);
+    std::vector<bool> started(threads, false);
+
+    for (unsigned int w = 0; w < threads; ++w)
+    {
+        slices[w].task = &task;
+        slices[w].begin = count * w / threads;
+        slices[w].end = count * (w + 1) / threads;
+        slices[w].worker = w;
+    }
+    for (unsigned int w = 1; w < threads; ++w)
+        started[w] = (pthread_create(&ids[w], NULL, runSlice, &slices[w]) == 0);
+    runSlice(&slices[0]);
+    for (unsigned int w = 1; w < threads; ++w)
+    {
+        if (started[w])
+            pthread_join(ids[w], NULL);
+        else
+            runSlice(&slices[w]);
+    }
+}
+
+/* Threads actually used for n values */
+static unsigned int effectiveThreads(std::size_t n, unsigned int threads)
+{
+    return (threads > 1 && n >= PARALLEL_THRESHOLD) ? threads : 1;
+}
+
+unsigned int hardwareThreads()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (count > 0) ? static_cast<unsigned int>(count) : 1;
+}
+
+/*** reductions ***/
+
+/* 8 independent lanes without branches: the loop body becomes vector min/max */
+static void minMaxSequential(const int* data, std::size_t n, int& min, int& max)
+{
+    int lo[8];
+    int hi[8];
+    std::size_t i = 0;
+
+    for (int l = 0; l < 8; ++l)
+    {
+        lo[l] = data[0];
+        hi[l] = data[0];
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        for (int l = 0; l < 8; ++l)
+        {
+            lo[l] = (data[i + l] < lo[l]) ? data[i + l] : lo[l];
+            hi[l] = (data[i + l] > hi[l]) ? data[i + l] : hi[l];
+        }
+    }
+    for (; i < n; ++i)
+    {
+        lo[0] = (data[i] < lo[0]) ? data[i] : lo[0];
+        hi[0] = (data[i] > hi[0]) ? data[i] : hi[0];
+    }
+    min = *std::min_element(lo, lo + 8);
+    max = *std::max_element(hi, hi + 8);
+}
+
+class MinMaxTask : public KernelTask
+{
+public:
+    MinMaxTask(const int* data, unsigned int threads) : _data(data), lo(threads), hi(threads) {}
+
+    void run(std::size_t begin, std::size_t end, unsigned int worker)
+    {
+        minMaxSequential(_data + begin, end - begin, lo[worker], hi[worker]);
+    }
+
+private:
+    const int* _data;
+
+public:
+    std::vector<int> lo;
+    std::vector<int> hi;
+};
+
+void minMax(const int* data, std::size_t n, int& min, int& max, unsigned int threads)
+{
+    threads = effectiveThreads(n, threads);
+    if (threads == 1)
+    {
+        minMaxSequential(data, n, min, max);
+        return;
+    }
+
+    MinMaxTask task(data, threads);
+
+    parallelFor(n, threads, task);
+    min = *std::min_element(task.lo.begin(), task.lo.end());
+    max = *std::max_element(task.hi.begin(), task.hi.end());
+}
+
+/*
+ * Gaps sorted[i + 1] - sorted[i] for i in [begin, end). In a sorted sequence
+ * the difference always fits an unsigned int (at most 2^32 - 1), so the lanes
+ * stay 32-bit wide and vectorize.
+ */
+static unsigned int minGapSequential(const int* sorted, std::size_t begin, std::size_t end)
+{
+    unsigned int lanes[8];
+    std::size_t i = begin;
+
+    for (int l = 0; l < 8; ++l)
+        lanes[l] = ~0u;
+    for (; i + 8 <= end; i += 8)
+    {
+        for (int l = 0; l < 8; ++l)
+        {
+            unsigned int gap = static_cast<unsigned int>(sorted[i + l + 1]) - static_cast<unsigned int>(sorted[i + l]);
+            lanes[l] = (gap < lanes[l]) ? gap : lanes[l];
+        }
+    }
+    for (; i < end; ++i)
+    {
+        unsigned int gap = static_cast<unsigned int>(sorted[i + 1]) - static_cast<unsigned int>(sorted[i]);
+        lanes[0] = (gap < lanes[0]) ? gap : lanes[0];
+    }
+    return *std::min_element(lanes, lanes + 8);
+}
+
+class MinGapTask : public KernelTask
+{
+public:
+    MinGapTask(const int* sorted, unsigned int threads) : _sorted(sorted), gaps(threads, ~0u) {}
+
+    void run(std::size_t begin, std::size_t end, unsigned int worker)
+    {
+        gaps[worker] = minGapSequential(_sorted, begin, end);
+    }
+
+private:
+    const int* _sorted;
+
+public:
+    std::vector<unsigned int> gaps;
+};
+
+long long minAdjacentGap(const int* sorted, std::size_t n, unsigned int threads)
+{
+    threads = effectiveThreads(n, threads);
+    if (threads == 1)
+        return static_cast<long long>(minGapSequential(sorted, 0, n - 1));
+
+    MinGapTask task(sorted, threads);
+
+    parallelFor(n - 1, threads, task);
+    return static_cast<long long>(*std::min_element(task.gaps.begin(), task.gaps.end()));
+}
+
+/*** sorting ***/
+
+/* The sign bit is flipped so that the unsigned order of the keys is the int order */
+static unsigned int radixKey(int value)
+{
+    return static_cast<unsigned int>(value) ^ 0x80000000u;
+}
+
+/*
+ * One pass of the parallel radix sort: every worker counts the digits of its
+ * block, then scatters its block from its own offsets. The offsets are
+ * assigned worker by worker within each digit, which keeps the pass stable.
+ */
+class RadixTask : public KernelTask
+{
+public:
+    RadixTask(const std::vector<int>& from, std::vector<int>& to, unsigned int shift, unsigned int threads)
+        : _from(from), _to(to), _shift(shift), counting(true), counts(threads, std::vector<std::size_t>(256, 0)) {}
+
+    void run(std::size_t begin, std::size_t end, unsigned int worker)
+    {
+        std::vector<std::size_t>& count = counts[worker];
+
+        if (counting)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                ++count[(radixKey(_from[i]) >> _shift) & 0xFF];
+            return;
+        }
+        for (std::size_t i = begin; i < end; ++i)
+            _to[count[(radixKey(_from[i]) >> _shift) & 0xFF]++] = _from[i];
+    }
+
+private:
+    const std::vector<int>& _from;
+    std::vector<int>& _to;
+    unsigned int _shift;
+
+public:
+    bool counting;
+    std::vector<std::vector<std::size_t> > counts;
+};
+
+void radixSort(std::vector<int>& values, unsigned int threads)
+{
+    const std::size_t n = values.size();
+
+    threads = effectiveThreads(n, threads);
+
+    std::vector<int> buffer(n);
+
+    for (unsigned int shift = 0; shift < 32; shift += 8)
+    {
+        RadixTask task(values, buffer, shift, threads);
+
+        task.counting = true;
+        if (threads == 1)
+            task.run(0, n, 0);
+        else
+            parallelFor(n, threads, task);
+
+        /* a digit shared by every value leaves the order unchanged */
+        bool single = false;
+        for (std::size_t digit = 0; digit < 256 && !single; ++digit)
+        {
+            std::size_t total = 0;
+            for (unsigned int w = 0; w < threads; ++w)
+                total += task.counts[w][digit];
+            single = (total == n);
+        }
+        if (single)
+            continue;
+
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < 256; ++digit)
+        {
+            for (unsigned int w = 0; w < threads; ++w)
+            {
+                std::size_t count = task.counts[w][digit];
+                task.counts[w][digit] = offset;
+                offset += count;
+            }
+        }
+
+        task.counting = false;
+        if (threads == 1)
+            task.run(0, n, 0);
+        else
+            parallelFor(n, threads, task);
+        values.swap(buffer);
+    }
+}
+
+/* Sorts each slice, then (merging = true) merges pairs of neighbouring blocks */
+class SortTask : public KernelTask
+{
+public:
+    SortTask(std::vector<int>& values, const std::vector<std::size_t>& bounds)
+        : _values(values), _bounds(bounds), width(0) {}
+
+    void run(std::size_t begin, std::size_t end, unsigned int)
+    {
+        for (std::size_t block = begin; block < end; ++block)
+        {
+            if (width == 0)
+            {
+                std::sort(_values.begin() + _bounds[block], _values.begin() + _bounds[block + 1]);
+                continue;
+            }
+
+            std::size_t first = block * 2 * width;
+            std::size_t middle = std::min(first + width, _bounds.size() - 1);
+            std::size_t last = std::min(first + 2 * width, _bounds.size() - 1);
+            std::inplace_merge(_values.begin() + _bounds[first], _values.begin() + _bounds[middle],
+                _values.begin() + _bounds[last]);
+        }
+    }
+
+private:
+    std::vector<int>& _values;
+    const std::vector<std::size_t>& _bounds;
+
+public:
+    /* 0 while sorting the blocks, then the number of blocks already merged together */
+    std::size_t width;
+};
+
+void standardSort(std::vector<int>& values, unsigned int threads)
+{
+    threads = effectiveThreads(values.size(), threads);
+    if (threads == 1)
+    {
+        std::sort(values.begin(), values.end());
+        return;
+    }
+
+    std::vector<std::size_t> bounds;
+
+    for (unsigned int w = 0; w <= threads; ++w)
+        bounds.push_back(values.size() * w / threads);
+
+    SortTask task(values, bounds);
+
+    parallelFor(threads, threads, task);
+    for (task.width = 1; task.width < threads; task.width *= 2)
+    {
+        std::size_t pairs = (threads + 2 * task.width - 1) / (2 * task.width);
+        parallelFor(pairs, static_cast<unsigned int>(pairs), task);
+    }
+}
+
+/*** random fill ***/
+
+unsigned long long mixSeed(unsigned long long value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/* PCG32 (XSH RR): 64-bit LCG state, 32-bit permuted output */
+class Pcg32
+{
+public:
+    Pcg32(unsigned long long seed, unsigned long long stream)
+        : _state(0), _increment((stream << 1) | 1)
+    {
+        next();
+        _state += seed;
+        next();
+    }
+
+    unsigned int next()
+    {
+        unsigned long long old = _state;
+        _state = old * 6364136223846793005ULL + _increment;
+        unsigned int xorshifted = static_cast<unsigned int>(((old >> 18) ^ old) >> 27);
+        unsigned int rotation = static_cast<unsigned int>(old >> 59);
+        return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+    }
+
+private:
+    unsigned long long _state;
+    unsigned long long _increment;
+};
+
+/*
+ * Uniform value below range (1 <= range <= 2^32, 2^32 meaning any 32-bit
+ * value): the high half of a 32x32 bit product, the low half rejecting the
+ * few draws that would make some results more likely (Lemire's method, no
+ * division except when a draw lands in the biased zone).
+ */
+static unsigned int uniformBelow(Pcg32& generator, unsigned long long range)
+{
+    if (range > 0xFFFFFFFFULL)
+        return generator.next();
+
+    unsigned long long product = static_cast<unsigned long long>(generator.next()) * range;
+    unsigned int low = static_cast<unsigned int>(product);
+
+    if (low < range)
+    {
+        unsigned int threshold = static_cast<unsigned int>((0x100000000ULL - range) % range);
+        while (low < threshold)
+        {
+            product = static_cast<unsigned long long>(generator.next()) * range;
+            low = static_cast<unsigned int>(product);
+        }
+    }
+    return static_cast<unsigned int>(product >> 32);
+}
+
+/* Fills the blocks [begin, end) of the output */
+class FillTask : public KernelTask
+{
+public:
+    FillTask(int* out, std::size_t n, int min, int max, unsigned long long seed)
+        : _out(out), _n(n), _min(min), _range(static_cast<unsigned long long>(static_cast<long long>(max) - min) + 1),
+        _seed(seed) {}
+
+    void run(std::size_t begin, std::size_t end, unsigned int)
+    {
+        for (std::size_t block = begin; block < end; ++block)
+        {
+            Pcg32 generator(mixSeed(_seed), mixSeed(_seed ^ mixSeed(block)));
+            std::size_t first = block * RANDOM_BLOCK_SIZE;
+            std::size_t last = std::min(first + RANDOM_BLOCK_SIZE, _n);
+
+            for (std::size_t i = first; i < last; ++i)
+                _out[i] = static_cast<int>(static_cast<long long>(_min) + uniformBelow(generator, _range));
+        }
+    }
+
+private:
+    int* _out;
+    std::size_t _n;
+    int _min;
+    unsigned long long _range;
+    unsigned long long _seed;
+};
+
+void fillUniform(int* out, std::size_t n, int min, int max, unsigned long long seed, unsigned int threads)
+{
+    std::size_t blocks = (n + RANDOM_BLOCK_SIZE - 1) / RANDOM_BLOCK_SIZE;
+    FillTask task(out, n, min, max, seed);
+
+    threads = effectiveThreads(n, threads);
+    if (threads > blocks)
+        threads = static_cast<unsigned int>(blocks);
+    if (threads <= 1)
+        task.run(0, blocks, 0);
+    else
+        parallelFor(blocks, threads, task);
+}
@@ -0,0 +1,48 @@
+#ifndef SPANKERNELS_HPP
+#define SPANKERNELS_HPP
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * Kernels used by Span when its statistics have to be computed from scratch
+ *
+ * The reductions keep 8 independent lanes of branchless min/max so the
+ * compiler turns them into SIMD instructions (-O2). Every kernel takes a
+ * thread count: inputs of at least PARALLEL_THRESHOLD values are split into
+ * that many contiguous blocks handled by POSIX threads, smaller ones run on
+ * the calling thread.
+ */
+
+/* Below this many values the kernels stay on the calling thread */
+static const std::size_t	PARALLEL_THRESHOLD = 10000000;
+
+/* Number of online processors (1 if it cannot be determined) */
+unsigned int	hardwareThreads();
+
+/* Smallest and largest of data[0, n) in one pass (n > 0) */
+void	minMax(const int* data, std::size_t n, int& min, int& max, unsigned int threads = 1);
+
+/* Smallest difference between neighbours of sorted[0, n) (n > 1), exact over the whole int range */
+long long	minAdjacentGap(const int* sorted, std::size_t n, unsigned int threads = 1);
+
+/* LSD radix sort, 4 passes of 8 bits (passes where every value shares the digit are skipped) */
+void	radixSort(std::vector<int>& values, unsigned int threads = 1);
+
+/* std::sort, on blocks sorted by several threads then merged when threads > 1 */
+void	standardSort(std::vector<int>& values, unsigned int threads = 1);
+
+/* Values per block of fillUniform: each block has its own generator */
+static const std::size_t	RANDOM_BLOCK_SIZE = 1 << 16;
+
+/*
+ * Fills out[0, n) with uniform ints in [min, max] (PCG32, unbiased range
+ * reduction). Block b of RANDOM_BLOCK_SIZE values is generated from (seed, b)
+ * alone, so the output depends on the seed only, not on the thread count.
+ */
+void	fillUniform(int* out, std::size_t n, int min, int max, unsigned long long seed, unsigned int threads = 1);
+
+/* Mixes a 64-bit value (splitmix64 finalizer), used to derive seeds */
+unsigned long long	mixSeed(unsigned long long value);
+
+#endif
@@ -0,0 +1,146 @@
+#include "WindowSpan.hpp"
+
+/*** parameterized constructor ***/
+WindowSpan::WindowSpan(unsigned int N)
+    : _ring(N), _windowSize(N), _head(0), _count(0), _pushed(0)
+{
+    if (N == 0)
+        throw std::invalid_argument("Window size must be at least 1");
+}
+
+/*** copy constructor ***/
+WindowSpan::WindowSpan(const WindowSpan& other)
+    : _ring(other._ring), _windowSize(other._windowSize), _head(other._head), _count(other._count),
+    _pushed(other._pushed), _minDeque(other._minDeque), _maxDeque(other._maxDeque),
+    _values(other._values), _gaps(other._gaps) {}
+
+/*** assignment operator ***/
+WindowSpan& WindowSpan::operator=(const WindowSpan& other)
+{
+    if (this != &other)
+    {
+        _ring = other._ring;
+        _windowSize = other._windowSize;
+        _head = other._head;
+        _count = other._count;
+        _pushed = other._pushed;
+        _minDeque = other._minDeque;
+        _maxDeque = other._maxDeque;
+        _values = other._values;
+        _gaps = other._gaps;
+    }
+    return *this;
+}
+
+/*** destructor ***/
+WindowSpan::~WindowSpan() {}
+
+/*** public methods ***/
+
+/* add a number to the window, dropping the oldest one when it is full */
+void WindowSpan::push(int num)
+{
+    if (_count == _windowSize) {
+        eraseValue(_ring[_head]);
+        --_count;
+    }
+    _ring[_head] = num;
+    _head = (_head + 1) % _windowSize;
+    ++_count;
+    insertValue(num);
+
+    /* entries pushed before the window start have left it */
+    unsigned long index = _pushed++;
+    while (!_minDeque.empty() && _minDeque.front().second + _windowSize <= index)
+        _minDeque.pop_front();
+    while (!_maxDeque.empty() && _maxDeque.front().second + _windowSize <= index)
+        _maxDeque.pop_front();
+
+    /* an entry that is older and not smaller (not larger) can never be the minimum (maximum) again */
+    while (!_minDeque.empty() && _minDeque.back().first >= num)
+        _minDeque.pop_back();
+    _minDeque.push_back(Entry(num, index));
+    while (!_maxDeque.empty() && _maxDeque.back().first <= num)
+        _maxDeque.pop_back();
+    _maxDeque.push_back(Entry(num, index));
+}
+
+/* Method to calculate the shortest span of the window */
+long long WindowSpan::shortestSpan() const
+{
+    if (_count < 2) {
+        throw std::logic_error("Not enough numbers to calculate a span (need at least 2)");
+    }
+    return *_gaps.begin();
+}
+
+/* Method to calculate the longest span of the window */
+long long WindowSpan::longestSpan() const
+{
+    if (_count < 2) {
+        throw std::logic_error("Not enough numbers to calculate a span (need at least 2)");
+    }
+    return static_cast<long long>(_maxDeque.front().first) - _minDeque.front().first;
+}
+
+/* Utility methods */
+unsigned int WindowSpan::size() const {
+    return _count;
+}
+
+unsigned int WindowSpan::capacity() const {
+    return _windowSize;
+}
+
+bool WindowSpan::full() const {
+    return _count == _windowSize;
+}
+
+void WindowSpan::clear() {
+    _head = 0;
+    _count = 0;
+    _pushed = 0;
+    _minDeque.clear();
+    _maxDeque.clear();
+    _values.clear();
+    _gaps.clear();
+}
+
+/* Inserts num between its neighbours lo and hi: gap (hi - lo) becomes (num - lo) and (hi - num) */
+void WindowSpan::insertValue(int num)
+{
+    std::multiset<int>::iterator it = _values.insert(num);
+    std::multiset<int>::iterator next = it;
+    bool hasNext = (++next != _values.end());
+    bool hasPrevious = (it != _values.begin());
+    std::multiset<int>::iterator previous = it;
+
+    if (hasPrevious)
+        --previous;
+    if (hasNext && hasPrevious)
+        _gaps.erase(_gaps.find(static_cast<long long>(*next) - *previous));
+    if (hasNext)
+        _gaps.insert(static_cast<long long>(*next) - num);
+    if (hasPrevious)
+        _gaps.insert(static_cast<long long>(num) - *previous);
+}
+
+/* Removes one num: its two gaps merge back into (hi - lo) */
+void WindowSpan::eraseValue(int num)
+{
+    std::multiset<int>::iterator it = _values.find(num);
+    std::multiset<int>::iterator next = it;
+    bool hasNext = (++next != _values.end());
+    bool hasPrevious = (it != _values.begin());
+    std::multiset<int>::iterator previous = it;
+
+    if (hasPrevious)
+        --previous;
+    if (hasNext)
+        _gaps.erase(_gaps.find(static_cast<long long>(*next) - num));
+    if (hasPrevious)
+        _gaps.erase(_gaps.find(static_cast<long long>(num) - *previous));
+    if (hasNext && hasPrevious)
+        _gaps.insert(static_cast<long long>(*next) - *previous);
+    _values.erase(it);
+}
@@ -0,0 +1,68 @@
+#ifndef WINDOWSPAN_HPP
+#define WINDOWSPAN_HPP
+
+#include <vector>
+#include <deque>
+#include <set>
+#include <utility>
+#include <stdexcept>
+
+/**
+ * WindowSpan: shortest and longest span over the last N numbers of a stream
+ *
+ * Unlike Span it never gets full: push() drops the oldest number once N are
+ * held. The window lives in a ring buffer; longestSpan reads the fronts of
+ * two monotonic deques (the oldest minimum and maximum still in the window,
+ * amortized O(1) per push), and shortestSpan the smallest element of a
+ * multiset of the gaps between neighbours in a multiset of the values
+ * (O(log N) per push: each insertion or removal replaces at most two gaps).
+ * Both queries are O(1) and 64-bit, so INT_MIN..INT_MAX does not overflow.
+ */
+class WindowSpan
+{
+public:
+	/*** parameterized constructor ***/
+	WindowSpan(unsigned int N);
+	/*** copy constructor ***/
+	WindowSpan(const WindowSpan& other);
+	/*** assignment operator ***/
+	WindowSpan& operator=(const WindowSpan& other);
+	/*** destructor ***/
+	~WindowSpan();
+
+	/*** public methods ***/
+
+	/* add a number to the window, dropping the oldest one when it is full */
+	void push(int num);
+
+	/* spans over the current window (at least 2 numbers) */
+	long long shortestSpan() const;
+	long long longestSpan() const;
+
+	/* Utility methods */
+	unsigned int size() const;
+	unsigned int capacity() const;
+	bool full() const;
+	void clear();
+
+private:
+	/* (value, push index): the index tells when an entry leaves the window */
+	typedef std::pair<int, unsigned long> Entry;
+
+	std::vector<int> _ring;
+	unsigned int _windowSize;
+	unsigned int _head;
+	unsigned int _count;
+	unsigned long _pushed;
+
+	std::deque<Entry> _minDeque;
+	std::deque<Entry> _maxDeque;
+
+	std::multiset<int> _values;
+	std::multiset<long long> _gaps;
+
+	void insertValue(int num);
+	void eraseValue(int num);
+};
+
+#endif
@@ -1,8 +1,11 @@
 #include "Span.hpp"
+#include "WindowSpan.hpp"
 #include <iostream>
 #include <vector>
 #include <ctime>
 #include <cstdlib>
+#include <climits>
+#include <time.h>
 
 void testBasicFunctionality() {
     std::cout << "=== Basic Functionality Test ===" << std::endl;
@@ -60,6 +63,221 @@ void testRangeInsert() {
     std::cout << "Longest Span: " << sp.longestSpan() << std::endl;
 }
 
+void testIncrementalSpans() {
+    std::cout << "\n=== Incremental Spans Test ===" << std::endl;
+    const int nums[] = { 50, 10, 80, 45, 47, 100, 46 };
+    Span sp(7);
+
+    sp.addNumber(nums[0]);
+    for (size_t i = 1; i < sizeof(nums) / sizeof(nums[0]); ++i) {
+        sp.addNumber(nums[i]);
+        std::cout << "After adding " << nums[i] << ": shortest " << sp.shortestSpan()
+            << ", longest " << sp.longestSpan() << std::endl;
+    }
+}
+
+/* Monotonic time in milliseconds */
+static double nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* The former shortestSpan: sorted copy, then a scalar loop over the gaps */
+static long long scalarShortestSpan(const std::vector<int>& numbers) {
+    std::vector<int> sorted = numbers;
+    std::sort(sorted.begin(), sorted.end());
+    long long minSpan = static_cast<long long>(sorted[1]) - sorted[0];
+    for (size_t i = 1; i < sorted.size(); i++) {
+        long long currentSpan = static_cast<long long>(sorted[i]) - sorted[i - 1];
+        if (currentSpan < minSpan)
+            minSpan = currentSpan;
+    }
+    return minSpan;
+}
+
+void testKernelBenchmark() {
+    std::cout << "\n=== Kernel Benchmark (10,000,000 numbers) ===" << std::endl;
+    const size_t size = 10000000;
+    const unsigned int threads = std::max(2u, hardwareThreads());
+    std::vector<int> numbers(size);
+
+    std::srand(42);
+    for (size_t i = 0; i < size; ++i)
+        numbers[i] = std::rand() - RAND_MAX / 2;
+
+    double start = nowMs();
+    int low = *std::min_element(numbers.begin(), numbers.end());
+    int high = *std::max_element(numbers.begin(), numbers.end());
+    std::cout << "min_element + max_element:   " << nowMs() - start << " ms (" << low << ", " << high << ")" << std::endl;
+
+    start = nowMs();
+    minMax(&numbers[0], size, low, high);
+    std::cout << "minMax:                      " << nowMs() - start << " ms (" << low << ", " << high << ")" << std::endl;
+
+    start = nowMs();
+    minMax(&numbers[0], size, low, high, threads);
+    std::cout << "minMax, " << threads << " threads:           " << nowMs() - start << " ms" << std::endl;
+
+    start = nowMs();
+    long long gap = scalarShortestSpan(numbers);
+    std::cout << "std::sort + scalar gaps:     " << nowMs() - start << " ms (" << gap << ")" << std::endl;
+
+    const Span::SortMethod methods[] = { Span::SORT_STD, Span::SORT_RADIX };
+    const char* names[] = { "std::sort", "radix sort" };
+    for (int m = 0; m < 2; ++m) {
+        const unsigned int counts[] = { 1, threads };
+        for (int t = 0; t < 2; ++t) {
+            Span sp(size);
+            sp.setSortMethod(methods[m]);
+            sp.setThreads(counts[t]);
+            sp.addNumber(numbers.begin(), numbers.end());
+            start = nowMs();
+            gap = sp.shortestSpan();
+            std::cout << "Span, " << names[m] << ", " << counts[t] << " thread(s): "
+                << nowMs() - start << " ms (" << gap << ")" << std::endl;
+        }
+    }
+}
+
+void testSlidingWindow() {
+    std::cout << "\n=== Sliding Window Test (last 4 numbers) ===" << std::endl;
+    const int stream[] = { 10, 20, 22, 50, 51, 90, INT_MIN, INT_MAX };
+    WindowSpan window(4);
+
+    for (size_t i = 0; i < sizeof(stream) / sizeof(stream[0]); ++i) {
+        window.push(stream[i]);
+        std::cout << "Push " << stream[i] << " [" << window.size() << "/" << window.capacity() << "]";
+        if (window.size() >= 2)
+            std::cout << ": shortest " << window.shortestSpan() << ", longest " << window.longestSpan();
+        std::cout << std::endl;
+    }
+
+    const unsigned int pushes = 1000000;
+    WindowSpan large(1000);
+    long long total = 0;
+    double start = nowMs();
+    std::srand(7);
+    for (unsigned int i = 0; i < pushes; ++i) {
+        large.push(std::rand());
+        if (large.size() >= 2)
+            total += large.longestSpan() - large.shortestSpan();
+    }
+    std::cout << pushes << " pushes and queries on a window of 1000: " << nowMs() - start
+        << " ms (checksum " << total << ")" << std::endl;
+}
+
+void testWideSpans() {
+    std::cout << "\n=== 64-bit Spans Test ===" << std::endl;
+    Span sp(3);
+    sp.addNumber(INT_MIN);
+    sp.addNumber(INT_MAX);
+    std::cout << "INT_MIN, INT_MAX: shortest " << sp.shortestSpan() << ", longest " << sp.longestSpan() << std::endl;
+    sp.addNumber(0);
+    std::cout << "+ 0: shortest " << sp.shortestSpan() << ", longest " << sp.longestSpan() << std::endl;
+}
+
+/* 10^6 numbers by default; ./a.out --bulk [count] runs it at scale (10^8 takes ~1.6 GB and ~15 s) */
+void testBulkInsert(size_t size) {
+    std::cout << "\n=== Bulk Insert Test (" << size << " numbers) ===" << std::endl;
+    std::vector<int> source(size);
+    unsigned int state = 12345;
+
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 1664525u + 1013904223u;
+        source[i] = static_cast<int>(state);
+    }
+    source[size / 3] = INT_MIN;
+    source[size / 2] = INT_MAX;
+
+    /* repeated push_back, then the two scans the former longestSpan made */
+    double start = nowMs();
+    {
+        std::vector<int> numbers;
+        numbers.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            numbers.push_back(source[i]);
+        long long span = static_cast<long long>(*std::max_element(numbers.begin(), numbers.end()))
+            - *std::min_element(numbers.begin(), numbers.end());
+        std::cout << "push_back + min/max_element: " << nowMs() - start << " ms (longest " << span << ")" << std::endl;
+    }
+
+    Span sp(size);
+    start = nowMs();
+    sp.addNumber(source.begin(), source.end());
+    long long longest = sp.longestSpan();
+    std::cout << "bulk addNumber + longestSpan: " << nowMs() - start << " ms (longest " << longest << ")" << std::endl;
+
+    sp.setSortMethod(Span::SORT_RADIX);
+    start = nowMs();
+    long long shortest = sp.shortestSpan();
+    std::cout << "shortestSpan (radix sort):    " << nowMs() - start << " ms (shortest " << shortest << ")" << std::endl;
+
+    /* per-element addNumber keeps the multiset up to date: compared on up to 10^6 numbers */
+    const size_t small = std::min(size, static_cast<size_t>(1000000));
+    Span single(small);
+    start = nowMs();
+    for (size_t i = 0; i < small; ++i)
+        single.addNumber(source[i]);
+    std::cout << small << " x addNumber(int):     " << nowMs() - start << " ms" << std::endl;
+    Span bulk(small);
+    start = nowMs();
+    bulk.addNumber(&source[0], &source[0] + small);
+    std::cout << "addNumber(" << small << " range):     " << nowMs() - start << " ms" << std::endl;
+}
+
+void testReproducibleFill() {
+    std::cout << "\n=== Reproducible Fill Test (10,000,000 numbers) ===" << std::endl;
+    const unsigned int size = 10000000;
+    const unsigned int threads = std::max(2u, hardwareThreads());
+
+    /* the former fill: reseeded rand() and a biased modulo, one element at a time */
+    double start = nowMs();
+    {
+        std::vector<int> numbers;
+        numbers.reserve(size);
+        std::srand(static_cast<unsigned int>(std::time(NULL)));
+        while (numbers.size() < size)
+            numbers.push_back(1 + std::rand() % 1000000);
+    }
+    std::cout << "rand() % range:           " << nowMs() - start << " ms" << std::endl;
+
+    Span first(size);
+    start = nowMs();
+    first.fillRandomly(1, 1000000, 42);
+    std::cout << "PCG32, seed 42, 1 thread:  " << nowMs() - start << " ms" << std::endl;
+
+    Span second(size);
+    start = nowMs();
+    second.fillRandomly(1, 1000000, 42, threads);
+    std::cout << "PCG32, seed 42, " << threads << " threads: " << nowMs() - start << " ms" << std::endl;
+
+    bool same = true;
+    for (unsigned int i = 0; i < size && same; ++i)
+        same = (first.at(i) == second.at(i));
+    std::cout << "Same numbers for both thread counts: " << (same ? "yes" : "no") << std::endl;
+
+    Span a(5);
+    Span b(5);
+    a.fillRandomly(INT_MIN, INT_MAX, 7);
+    b.fillRandomly(INT_MIN, INT_MAX, 7);
+    std::cout << "Seed 7, full int range: ";
+    a.print();
+    std::cout << "Seed 7 again:           ";
+    b.print();
+
+    Span c(5);
+    c.fillRandomly(1, 6);
+    c.clear();
+    Span d(c);
+    c.fillRandomly(1, 6);
+    d.fillRandomly(1, 6);
+    std::cout << "Two unseeded fills:     ";
+    c.print();
+    std::cout << "                        ";
+    d.print();
+}
+
 void testErrorHandling() {
     std::cout << "\n=== Error Handling Test ===" << std::endl;
     
@@ -94,11 +312,31 @@ void testErrorHandling() {
     }
 }
 
-int main() {
+int main(int argc, char** argv) {
+    size_t bulkSize = 1000000;
+
+    if (argc > 1 && std::string(argv[1]) == "--bulk") {
+        bulkSize = 100000000;
+        if (argc > 2) {
+            long count = std::atol(argv[2]);
+            if (count < 2) {
+                std::cerr << "Error: --bulk needs a count of at least 2" << std::endl;
+                return 1;
+            }
+            bulkSize = static_cast<size_t>(count);
+        }
+    }
+
     testBasicFunctionality();
     testRandomNumbers();
     testLargeNumbers();
     testRangeInsert();
+    testIncrementalSpans();
+    testKernelBenchmark();
+    testSlidingWindow();
+    testWideSpans();
+    testBulkInsert(bulkSize);
+    testReproducibleFill();
     testErrorHandling();
     
     return 0;
@@ -0,0 +1,85 @@
+#ifndef CONCURRENTSTACK_HPP
+#define CONCURRENTSTACK_HPP
+
+#include "MutantStack.hpp"
+#include <vector>
+#include <cstddef>
+
+/* ConcurrentStack: lock-free stack shared between threads (Treiber stack) */
+/**
+ * push and pop never block: each one is a single compare-and-swap on the head
+ * word, retried when another thread got there first.
+ *
+ * Why tagged indices?
+ * A plain Treiber stack suffers from ABA: a pop reads head A and its next B, is
+ * preempted while A is popped, B is popped and A is pushed back, then its CAS
+ * succeeds and installs the stale B. Here nodes come from a pool owned by the
+ * stack and are named by a 32-bit index; the head packs that index with a
+ * 32-bit tag bumped by every successful CAS, so a head that changed in between
+ * never compares equal (short of 2^32 operations during one preemption).
+ * Popped nodes go to a free list (the same tagged stack) and are reused, never
+ * freed before the ConcurrentStack itself, so a thread reading a node it lost
+ * the race for still reads valid memory.
+ *
+ * Values are copied in and out of nodes without locking: T should be a plain
+ * value type (ints, pointers, small structs of them), default constructible.
+ */
+template <typename T>
+class ConcurrentStack {
+public:
+    typedef T value_type;
+    /* Snapshots iterate bottom to top, like MutantStack */
+    typedef MutantStack<T, std::vector<T> > snapshot_type;
+
+    /* Orthodox Canonical Form (copies go through a snapshot of other) */
+    ConcurrentStack();
+    ConcurrentStack(const ConcurrentStack& other);
+    ConcurrentStack& operator=(const ConcurrentStack& other);
+    ~ConcurrentStack();
+
+    /* Thread-safe operations */
+    void push(const T& value);
+    /* Pops the top into value, false if the stack was empty */
+    bool pop(T& value);
+    bool empty() const;
+
+    /**
+     * Consistent copy of the whole stack: the list is walked from the head,
+     * then kept only if the head word (index and tag) did not change meanwhile,
+     * i.e. no push or pop completed during the walk. Retried otherwise, so a
+     * snapshot can be delayed by a stream of writers but never sees a mix of
+     * two states.
+     */
+    snapshot_type snapshot() const;
+
+private:
+    struct Node {
+        T value;
+        volatile unsigned int next;
+    };
+
+    /* Node pool: chunk k holds CHUNK_BASE << k nodes, allocated on first use */
+    static const unsigned int CHUNK_BASE = 1024;
+    static const unsigned int MAX_CHUNKS = 22;
+
+    /* Head words sit on their own cache lines so pushers do not false-share */
+    volatile unsigned long long _head;
+    char _padHead[64 - sizeof(unsigned long long)];
+    volatile unsigned long long _free;
+    char _padFree[64 - sizeof(unsigned long long)];
+    volatile unsigned int _allocated;
+    Node* volatile _chunks[MAX_CHUNKS];
+
+    Node& node(unsigned int index) const;
+    unsigned int acquireNode();
+    void copyFrom(const ConcurrentStack& other);
+
+    static unsigned int headIndex(unsigned long long head);
+    static unsigned long long nextHead(unsigned long long head, unsigned int index);
+    static void pushIndex(volatile unsigned long long* head, Node& node, unsigned int index);
+    static unsigned int popIndex(volatile unsigned long long* head, const ConcurrentStack& stack);
+};
+
+/* TPP implementation */
+#include "ConcurrentStack.tpp"
+#endif
@@ -0,0 +1,172 @@
+/* TPP function implementation */
+
+#include <new>
+
+template <typename T>
+const unsigned int ConcurrentStack<T>::CHUNK_BASE;
+
+template <typename T>
+const unsigned int ConcurrentStack<T>::MAX_CHUNKS;
+
+/* Orthodox Canonical Form */
+template <typename T>
+ConcurrentStack<T>::ConcurrentStack() : _head(0), _free(0), _allocated(0) {
+    for (unsigned int k = 0; k < MAX_CHUNKS; ++k)
+        _chunks[k] = 0;
+}
+
+template <typename T>
+ConcurrentStack<T>::ConcurrentStack(const ConcurrentStack& other) : _head(0), _free(0), _allocated(0) {
+    for (unsigned int k = 0; k < MAX_CHUNKS; ++k)
+        _chunks[k] = 0;
+    copyFrom(other);
+}
+
+/* Not atomic as a whole: no other thread may use *this during the assignment */
+template <typename T>
+ConcurrentStack<T>& ConcurrentStack<T>::operator=(const ConcurrentStack& other) {
+    if (this != &other) {
+        T discarded;
+        while (pop(discarded))
+            ;
+        copyFrom(other);
+    }
+    return *this;
+}
+
+template <typename T>
+ConcurrentStack<T>::~ConcurrentStack() {
+    for (unsigned int k = 0; k < MAX_CHUNKS; ++k)
+        delete[] _chunks[k];
+}
+
+/* Thread-safe operations */
+template <typename T>
+void ConcurrentStack<T>::push(const T& value) {
+    unsigned int index = acquireNode();
+
+    node(index).value = value;
+    pushIndex(&_head, node(index), index);
+}
+
+template <typename T>
+bool ConcurrentStack<T>::pop(T& value) {
+    unsigned int index = popIndex(&_head, *this);
+
+    if (index == 0)
+        return false;
+    /* the CAS made this thread the node's only owner until it is released */
+    value = node(index).value;
+    pushIndex(&_free, node(index), index);
+    return true;
+}
+
+template <typename T>
+bool ConcurrentStack<T>::empty() const {
+    return headIndex(_head) == 0;
+}
+
+template <typename T>
+typename ConcurrentStack<T>::snapshot_type ConcurrentStack<T>::snapshot() const {
+    std::vector<T> values;
+
+    for (;;) {
+        unsigned long long head = _head;
+        unsigned int limit = _allocated;
+        unsigned int index = headIndex(head);
+
+        values.clear();
+        /* a walk longer than the pool went through recycled nodes: the head moved */
+        while (index != 0 && values.size() <= limit) {
+            values.push_back(node(index).value);
+            index = node(index).next;
+        }
+        __sync_synchronize();
+        if (index == 0 && _head == head)
+            break;
+    }
+
+    snapshot_type result;
+    for (typename std::vector<T>::reverse_iterator it = values.rbegin(); it != values.rend(); ++it)
+        result.push(*it);
+    return result;
+}
+
+/* Index i + 1 lives in chunk k = log2(i / CHUNK_BASE + 1), after the CHUNK_BASE * (2^k - 1) nodes of chunks 0..k-1 */
+template <typename T>
+typename ConcurrentStack<T>::Node& ConcurrentStack<T>::node(unsigned int index) const {
+    unsigned int i = index - 1;
+    unsigned int k = 31 - __builtin_clz(i / CHUNK_BASE + 1);
+
+    return _chunks[k][i - CHUNK_BASE * ((1u << k) - 1)];
+}
+
+/* A node from the free list, or the next never-used one (its chunk installed by CAS if missing) */
+template <typename T>
+unsigned int ConcurrentStack<T>::acquireNode() {
+    unsigned int index = popIndex(&_free, *this);
+
+    if (index != 0)
+        return index;
+
+    unsigned int i = __sync_fetch_and_add(&_allocated, 1);
+    unsigned int k = 31 - __builtin_clz(i / CHUNK_BASE + 1);
+
+    if (k >= MAX_CHUNKS) {
+        __sync_fetch_and_sub(&_allocated, 1);
+        throw std::bad_alloc();
+    }
+    if (_chunks[k] == 0) {
+        Node* chunk = new Node[CHUNK_BASE << k];
+        if (!__sync_bool_compare_and_swap(&_chunks[k], static_cast<Node*>(0), chunk))
+            delete[] chunk;
+    }
+    return i + 1;
+}
+
+template <typename T>
+void ConcurrentStack<T>::copyFrom(const ConcurrentStack& other) {
+    snapshot_type values = other.snapshot();
+
+    for (typename snapshot_type::const_iterator it = values.begin(); it != values.end(); ++it)
+        push(*it);
+}
+
+/* Head word: node index (0 = none) in the low 32 bits, tag in the high 32 bits */
+template <typename T>
+unsigned int ConcurrentStack<T>::headIndex(unsigned long long head) {
+    return static_cast<unsigned int>(head);
+}
+
+template <typename T>
+unsigned long long ConcurrentStack<T>::nextHead(unsigned long long head, unsigned int index) {
+    unsigned long long tag = (head >> 32) + 1;
+    return (tag << 32) | index;
+}
+
+/* Treiber push: link the node to the current head, publish it if the head did not move */
+template <typename T>
+void ConcurrentStack<T>::pushIndex(volatile unsigned long long* head, Node& node, unsigned int index) {
+    for (;;) {
+        unsigned long long old = *head;
+
+        node.next = headIndex(old);
+        if (__sync_bool_compare_and_swap(head, old, nextHead(old, index)))
+            return;
+    }
+}
+
+/* Treiber pop: swing the head to its successor; the tag makes a recycled head fail the CAS */
+template <typename T>
+unsigned int ConcurrentStack<T>::popIndex(volatile unsigned long long* head, const ConcurrentStack& stack) {
+    for (;;) {
+        unsigned long long old = *head;
+        unsigned int index = headIndex(old);
+
+        if (index == 0)
+            return 0;
+        unsigned int next = stack.node(index).next;
+        if (__sync_bool_compare_and_swap(head, old, nextHead(old, next)))
+            return index;
+    }
+}
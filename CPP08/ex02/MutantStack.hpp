@@ -7,29 +7,31 @@
 
 /* MutantStack: A stack with iterator support */
 /* Header implementation allowed for function template */
-template <typename T>
-class MutantStack : public std::stack<T> {
+template <typename T, typename Container = std::deque<T> >
+class MutantStack : public std::stack<T, Container> {
 public:
     /* Typedefs for iterator support */
     /**
-     * Why deque container?
-     * We use std::deque for iterator implementation in MutantStack because:
-     * 
-     * 1 - std::deque is the default underlying container for std::stack.
-     * 2 - std::deque provides efficient operations and full iterator support (random access and bidirectional).
-     * 3 - This allows MutantStack to extend std::stack by providing iterator-based functionality without reinventing the wheel.
+     * Why take them from Container?
+     * The iterators are the ones of the underlying container, like std::stack does for value_type:
+     *
+     * 1 - std::deque stays the default, as for std::stack, so MutantStack<T> behaves as before.
+     * 2 - Any sequence with push_back, pop_back, back and reverse iterators can be plugged in
+     *     (std::vector, std::list, or SmallVector for small stacks that never touch the heap).
+     * 3 - Iterating then costs what iterating the container costs (plain pointers for contiguous storage).
      */
-    typedef typename std::deque<T>::iterator iterator;
-    typedef typename std::deque<T>::const_iterator const_iterator;
-    typedef typename std::deque<T>::reverse_iterator reverse_iterator;
-    typedef typename std::deque<T>::const_reverse_iterator const_reverse_iterator;
+    typedef Container container_type;
+    typedef typename Container::iterator iterator;
+    typedef typename Container::const_iterator const_iterator;
+    typedef typename Container::reverse_iterator reverse_iterator;
+    typedef typename Container::const_reverse_iterator const_reverse_iterator;
 
     /* Orthodox Canonical Form */
-    MutantStack() : std::stack<T>() {}
-    MutantStack(const MutantStack& other) : std::stack<T>(other) {}
+    MutantStack() : std::stack<T, Container>() {}
+    MutantStack(const MutantStack& other) : std::stack<T, Container>(other) {}
     MutantStack& operator=(const MutantStack& other) {
         if (this != &other) {
-            std::stack<T>::operator=(other);
+            std::stack<T, Container>::operator=(other);
         }
         return *this;
     }
@@ -0,0 +1,97 @@
+#ifndef SMALLVECTOR_HPP
+#define SMALLVECTOR_HPP
+
+#include <cstddef>
+#include <iterator>
+
+/* SmallVector: contiguous sequence keeping its first N elements inline */
+/**
+ * Meant as the underlying container of MutantStack (push_back, pop_back,
+ * back, pointer iterators). The first N elements live in a buffer inside the
+ * object, so a stack that never grows past N is pushed, popped and iterated
+ * without touching the heap. Past N the elements move once to a heap block
+ * that doubles when full, like std::vector; they stay on the heap until the
+ * SmallVector is destroyed or assigned.
+ */
+template <typename T, std::size_t N = 16>
+class SmallVector {
+public:
+    typedef T value_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /* Orthodox Canonical Form */
+    SmallVector();
+    SmallVector(const SmallVector& other);
+    SmallVector& operator=(const SmallVector& other);
+    ~SmallVector();
+
+    /* Sequence operations used by std::stack */
+    void push_back(const T& value);
+    void pop_back();
+    reference back();
+    const_reference back() const;
+    size_type size() const;
+    bool empty() const;
+
+    /* Contiguous access */
+    reference operator[](size_type index);
+    const_reference operator[](size_type index) const;
+    size_type capacity() const;
+    void clear();
+    /* true while the elements are in the inline buffer */
+    bool isInline() const;
+
+    /* Iterator support: plain pointers */
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+
+private:
+    /* raw storage for N elements, aligned for any fundamental type */
+    union InlineBuffer {
+        unsigned char bytes[N * sizeof(T)];
+        long double alignLongDouble;
+        long long alignLongLong;
+        void* alignPointer;
+    };
+
+    InlineBuffer _inline;
+    T* _data;
+    size_type _size;
+    size_type _capacity;
+
+    T* inlineData();
+    void grow();
+};
+
+/* Comparisons, as std::stack forwards them to its container */
+template <typename T, std::size_t N>
+bool operator==(const SmallVector<T, N>& a, const SmallVector<T, N>& b);
+template <typename T, std::size_t N>
+bool operator!=(const SmallVector<T, N>& a, const SmallVector<T, N>& b);
+template <typename T, std::size_t N>
+bool operator<(const SmallVector<T, N>& a, const SmallVector<T, N>& b);
+template <typename T, std::size_t N>
+bool operator>(const SmallVector<T, N>& a, const SmallVector<T, N>& b);
+template <typename T, std::size_t N>
+bool operator<=(const SmallVector<T, N>& a, const SmallVector<T, N>& b);
+template <typename T, std::size_t N>
+bool operator>=(const SmallVector<T, N>& a, const SmallVector<T, N>& b);
+
+/* TPP implementation */
+#include "SmallVector.tpp"
+#endif
@@ -0,0 +1,181 @@
+/* TPP function implementation */
+
+#include <algorithm>
+#include <new>
+
+template <typename T, std::size_t N>
+T* SmallVector<T, N>::inlineData() {
+    return reinterpret_cast<T*>(_inline.bytes);
+}
+
+/* Orthodox Canonical Form */
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector() : _data(inlineData()), _size(0), _capacity(N) {}
+
+/* If a copy throws, the elements built so far and the heap block are freed (no destructor will run) */
+template <typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other) : _data(inlineData()), _size(0), _capacity(N) {
+    try {
+        for (size_type i = 0; i < other._size; ++i)
+            push_back(other._data[i]);
+    }
+    catch (...) {
+        clear();
+        if (_data != inlineData())
+            ::operator delete(_data);
+        throw;
+    }
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other) {
+    if (this != &other) {
+        clear();
+        for (size_type i = 0; i < other._size; ++i)
+            push_back(other._data[i]);
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N>
+SmallVector<T, N>::~SmallVector() {
+    clear();
+    if (_data != inlineData())
+        ::operator delete(_data);
+}
+
+/*
+ * Sequence operations used by std::stack. value may be an element of this
+ * vector (push(top())), which grow() destroys: a full vector copies it first.
+ */
+template <typename T, std::size_t N>
+void SmallVector<T, N>::push_back(const T& value) {
+    if (_size == _capacity) {
+        T copy(value);
+
+        grow();
+        new (_data + _size) T(copy);
+        ++_size;
+        return;
+    }
+    new (_data + _size) T(value);
+    ++_size;
+}
+
+template <typename T, std::size_t N>
+void SmallVector<T, N>::pop_back() {
+    --_size;
+    _data[_size].~T();
+}
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::reference SmallVector<T, N>::back() { return _data[_size - 1]; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::const_reference SmallVector<T, N>::back() const { return _data[_size - 1]; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::size_type SmallVector<T, N>::size() const { return _size; }
+
+template <typename T, std::size_t N>
+bool SmallVector<T, N>::empty() const { return _size == 0; }
+
+/* Contiguous access */
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::reference SmallVector<T, N>::operator[](size_type index) { return _data[index]; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::const_reference SmallVector<T, N>::operator[](size_type index) const { return _data[index]; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::size_type SmallVector<T, N>::capacity() const { return _capacity; }
+
+/* Destroys the elements, keeping the storage (inline or heap) for reuse */
+template <typename T, std::size_t N>
+void SmallVector<T, N>::clear() {
+    while (_size > 0)
+        pop_back();
+}
+
+template <typename T, std::size_t N>
+bool SmallVector<T, N>::isInline() const {
+    return _data == reinterpret_cast<const T*>(_inline.bytes);
+}
+
+/**
+ * Doubles the capacity: the elements are copied into a new heap block (the
+ * only allocation a growing stack makes per doubling), then destroyed in the
+ * old one. If a copy throws, the copies made so far are destroyed and the
+ * SmallVector is left unchanged.
+ */
+template <typename T, std::size_t N>
+void SmallVector<T, N>::grow() {
+    size_type capacity = _capacity * 2;
+    T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    size_type copied = 0;
+
+    try {
+        for (; copied < _size; ++copied)
+            new (data + copied) T(_data[copied]);
+    }
+    catch (...) {
+        while (copied > 0)
+            data[--copied].~T();
+        ::operator delete(data);
+        throw;
+    }
+    for (size_type i = 0; i < _size; ++i)
+        _data[i].~T();
+    if (_data != inlineData())
+        ::operator delete(_data);
+    _data = data;
+    _capacity = capacity;
+}
+
+/* Iterator support: plain pointers */
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::begin() { return _data; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::end() { return _data + _size; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::begin() const { return _data; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::end() const { return _data + _size; }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::reverse_iterator SmallVector<T, N>::rbegin() { return reverse_iterator(end()); }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::reverse_iterator SmallVector<T, N>::rend() { return reverse_iterator(begin()); }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::const_reverse_iterator SmallVector<T, N>::rbegin() const { return const_reverse_iterator(end()); }
+
+template <typename T, std::size_t N>
+typename SmallVector<T, N>::const_reverse_iterator SmallVector<T, N>::rend() const { return const_reverse_iterator(begin()); }
+
+/* Comparisons, as std::stack forwards them to its container */
+template <typename T, std::size_t N>
+bool operator==(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <typename T, std::size_t N>
+bool operator!=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) { return !(a == b); }
+
+template <typename T, std::size_t N>
+bool operator<(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template <typename T, std::size_t N>
+bool operator>(const SmallVector<T, N>& a, const SmallVector<T, N>& b) { return b < a; }
+
+template <typename T, std::size_t N>
+bool operator<=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) { return !(b < a); }
+
+template <typename T, std::size_t N>
+bool operator>=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) { return !(a < b); }
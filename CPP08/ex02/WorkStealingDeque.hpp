@@ -0,0 +1,74 @@
+#ifndef WORKSTEALINGDEQUE_HPP
+#define WORKSTEALINGDEQUE_HPP
+
+#include "MutantStack.hpp"
+#include <vector>
+
+/* WorkStealingDeque: Chase-Lev deque, one owner thread and any number of thieves */
+/**
+ * The owner uses it as its own stack: push and pop work at the bottom and
+ * touch no shared word except when a single element is left, where the owner
+ * races thieves for it with a CAS. Thieves call steal from any thread; it
+ * takes the oldest element at the top with one CAS on top.
+ *
+ * Why a circular array that only grows?
+ * Elements live at index % capacity in a power-of-two array. When the owner
+ * fills it, the live range is copied into an array twice as large; the old
+ * one is kept until the deque is destroyed, as a thief may still be reading
+ * it (the elements it holds stay valid, the owner only writes the new one).
+ *
+ * Like ConcurrentStack, T should be a plain value type (typically a task
+ * pointer): a thief may copy an element that it then fails to claim.
+ */
+template <typename T>
+class WorkStealingDeque {
+public:
+    typedef T value_type;
+    /* Snapshots iterate from the top (oldest) to the bottom (newest), like MutantStack */
+    typedef MutantStack<T, std::vector<T> > snapshot_type;
+
+    /* Orthodox Canonical Form (copies are made while neither deque is in use) */
+    explicit WorkStealingDeque(unsigned int capacity = 64);
+    WorkStealingDeque(const WorkStealingDeque& other);
+    WorkStealingDeque& operator=(const WorkStealingDeque& other);
+    ~WorkStealingDeque();
+
+    /* Owner thread only */
+    void push(const T& value);
+    /* Pops the newest element into value, false if the deque was empty */
+    bool pop(T& value);
+    /* Elements not yet stolen, oldest first (concurrent steals may have taken some since) */
+    snapshot_type snapshot() const;
+
+    /* Any thread: takes the oldest element, false if empty or another thread claimed it first */
+    bool steal(T& value);
+    bool empty() const;
+    /* Approximate while other threads are active */
+    unsigned int size() const;
+    unsigned int capacity() const;
+
+private:
+    struct Array {
+        long mask;
+        T* items;
+
+        explicit Array(long capacity) : mask(capacity - 1), items(new T[capacity]) {}
+        ~Array() { delete[] items; }
+        T& at(long index) { return items[index & mask]; }
+    };
+
+    volatile long _top;
+    char _padTop[64 - sizeof(long)];
+    volatile long _bottom;
+    Array* volatile _array;
+    /* Arrays replaced by grow, kept for thieves still reading them (owner only) */
+    std::vector<Array*> _retired;
+
+    Array* grow(Array* array, long top, long bottom);
+    void release();
+    void copyFrom(const WorkStealingDeque& other);
+};
+
+/* TPP implementation */
+#include "WorkStealingDeque.tpp"
+#endif
@@ -0,0 +1,159 @@
+/* TPP function implementation */
+
+/* Orthodox Canonical Form */
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(unsigned int capacity) : _top(0), _bottom(0) {
+    long rounded = 2;
+
+    while (rounded < static_cast<long>(capacity))
+        rounded *= 2;
+    _array = new Array(rounded);
+}
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(const WorkStealingDeque& other) : _top(0), _bottom(0) {
+    _array = new Array(other._array->mask + 1);
+    try {
+        copyFrom(other);
+    }
+    catch (...) {
+        release();
+        throw;
+    }
+}
+
+/* Copy and swap: if the copy throws, this deque is left unchanged */
+template <typename T>
+WorkStealingDeque<T>& WorkStealingDeque<T>::operator=(const WorkStealingDeque& other) {
+    if (this != &other) {
+        WorkStealingDeque copy(other);
+        Array* array = _array;
+        long top = _top;
+        long bottom = _bottom;
+
+        _array = copy._array;
+        _top = copy._top;
+        _bottom = copy._bottom;
+        _retired.swap(copy._retired);
+        copy._array = array;
+        copy._top = top;
+        copy._bottom = bottom;
+    }
+    return *this;
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+    release();
+}
+
+/* Owner thread only */
+template <typename T>
+void WorkStealingDeque<T>::push(const T& value) {
+    long bottom = _bottom;
+    long top = _top;
+    Array* array = _array;
+
+    if (bottom - top > array->mask)
+        array = grow(array, top, bottom);
+    array->at(bottom) = value;
+    /* the element must be visible before thieves can see the new bottom */
+    __sync_synchronize();
+    _bottom = bottom + 1;
+}
+
+/**
+ * Claims the bottom slot first, then reads top: the full barrier in between
+ * orders the store before the load, so a thief that read the old bottom is
+ * seen here. Only the last element is contended, and settled by a CAS on top.
+ */
+template <typename T>
+bool WorkStealingDeque<T>::pop(T& value) {
+    long bottom = _bottom - 1;
+    Array* array = _array;
+
+    _bottom = bottom;
+    __sync_synchronize();
+    long top = _top;
+
+    if (top > bottom) {
+        _bottom = bottom + 1;
+        return false;
+    }
+    value = array->at(bottom);
+    if (top < bottom)
+        return true;
+
+    bool won = __sync_bool_compare_and_swap(&_top, top, top + 1);
+    _bottom = top + 1;
+    return won;
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::snapshot_type WorkStealingDeque<T>::snapshot() const {
+    snapshot_type result;
+    Array* array = _array;
+
+    for (long index = _top; index < _bottom; ++index)
+        result.push(array->at(index));
+    return result;
+}
+
+/* Any thread */
+template <typename T>
+bool WorkStealingDeque<T>::steal(T& value) {
+    long top = _top;
+    __sync_synchronize();
+    long bottom = _bottom;
+
+    if (top >= bottom)
+        return false;
+    value = _array->at(top);
+    return __sync_bool_compare_and_swap(&_top, top, top + 1);
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::empty() const {
+    return _bottom <= _top;
+}
+
+template <typename T>
+unsigned int WorkStealingDeque<T>::size() const {
+    long size = _bottom - _top;
+
+    return size > 0 ? static_cast<unsigned int>(size) : 0;
+}
+
+template <typename T>
+unsigned int WorkStealingDeque<T>::capacity() const {
+    return static_cast<unsigned int>(_array->mask + 1);
+}
+
+/* Copies the live range [top, bottom) into an array twice as large, then publishes it */
+template <typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(Array* array, long top, long bottom) {
+    Array* larger = new Array(2 * (array->mask + 1));
+
+    for (long index = top; index < bottom; ++index)
+        larger->at(index) = array->at(index);
+    _retired.push_back(array);
+    __sync_synchronize();
+    _array = larger;
+    return larger;
+}
+
+template <typename T>
+void WorkStealingDeque<T>::release() {
+    for (typename std::vector<Array*>::iterator it = _retired.begin(); it != _retired.end(); ++it)
+        delete *it;
+    _retired.clear();
+    delete _array;
+}
+
+template <typename T>
+void WorkStealingDeque<T>::copyFrom(const WorkStealingDeque& other) {
+    snapshot_type values = other.snapshot();
+
+    for (typename snapshot_type::const_iterator it = values.begin(); it != values.end(); ++it)
+        push(*it);
+}
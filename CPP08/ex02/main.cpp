@@ -1,6 +1,368 @@
 #include "MutantStack.hpp"
+#include "SmallVector.hpp"
+#include "ConcurrentStack.hpp"
+#include "WorkStealingDeque.hpp"
 #include <iostream>
 #include <list>
+#include <vector>
+#include <string>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+
+static double nowMs() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* Many short-lived small stacks: push depth values, sum them through the iterators, pop them all */
+template <typename Stack>
+static double benchSmallStacks(const char* name, int stacks, int depth) {
+	long long sum = 0;
+	double start = nowMs();
+
+	for (int s = 0; s < stacks; ++s) {
+		Stack stack;
+		for (int i = 0; i < depth; ++i)
+			stack.push(s + i);
+		for (typename Stack::const_iterator it = stack.begin(); it != stack.end(); ++it)
+			sum += *it;
+		while (!stack.empty())
+			stack.pop();
+	}
+	double elapsed = nowMs() - start;
+	std::cout << "  " << name << ": " << elapsed << " ms (checksum " << sum << ")" << std::endl;
+	return elapsed;
+}
+
+/* One deep stack: push count values, then iterate it several times */
+template <typename Stack>
+static double benchLargeStack(const char* name, int count, int passes) {
+	Stack stack;
+	long long sum = 0;
+	double start = nowMs();
+
+	for (int i = 0; i < count; ++i)
+		stack.push(i);
+	for (int p = 0; p < passes; ++p)
+		for (typename Stack::const_iterator it = stack.begin(); it != stack.end(); ++it)
+			sum += *it;
+	double elapsed = nowMs() - start;
+	std::cout << "  " << name << ": " << elapsed << " ms (checksum " << sum << ")" << std::endl;
+	return elapsed;
+}
+
+/* Today's alternative to ConcurrentStack: a MutantStack behind a mutex */
+struct LockedStack {
+	MutantStack<int> stack;
+	pthread_mutex_t mutex;
+
+	LockedStack() { pthread_mutex_init(&mutex, NULL); }
+	~LockedStack() { pthread_mutex_destroy(&mutex); }
+
+	void push(int value) {
+		pthread_mutex_lock(&mutex);
+		stack.push(value);
+		pthread_mutex_unlock(&mutex);
+	}
+	bool pop(int& value) {
+		pthread_mutex_lock(&mutex);
+		bool popped = !stack.empty();
+		if (popped) {
+			value = stack.top();
+			stack.pop();
+		}
+		pthread_mutex_unlock(&mutex);
+		return popped;
+	}
+};
+
+struct StressTask {
+	ConcurrentStack<int>* stack;
+	int first;
+	int count;
+	std::vector<int> popped;
+};
+
+/* Pushes first..first+count-1, popping one value after every second push */
+static void* stressWorker(void* arg) {
+	StressTask* task = static_cast<StressTask*>(arg);
+	int value;
+
+	for (int i = 0; i < task->count; ++i) {
+		task->stack->push(task->first + i);
+		if (i % 2 == 1 && task->stack->pop(value))
+			task->popped.push_back(value);
+	}
+	return NULL;
+}
+
+/* Every pushed value must come out exactly once, popped by a worker or left in the stack */
+static bool stressConcurrentStack(int threads, int perThread) {
+	ConcurrentStack<int> stack;
+	std::vector<StressTask> tasks(threads);
+	std::vector<pthread_t> ids(threads);
+	std::vector<int> seen(threads * perThread, 0);
+
+	for (int t = 0; t < threads; ++t) {
+		tasks[t].stack = &stack;
+		tasks[t].first = t * perThread;
+		tasks[t].count = perThread;
+		pthread_create(&ids[t], NULL, stressWorker, &tasks[t]);
+	}
+	for (int t = 0; t < threads; ++t)
+		pthread_join(ids[t], NULL);
+
+	for (int t = 0; t < threads; ++t)
+		for (std::size_t i = 0; i < tasks[t].popped.size(); ++i)
+			++seen[tasks[t].popped[i]];
+	int value;
+	while (stack.pop(value))
+		++seen[value];
+	for (std::size_t i = 0; i < seen.size(); ++i)
+		if (seen[i] != 1)
+			return false;
+	return true;
+}
+
+struct SnapshotTask {
+	ConcurrentStack<int>* stack;
+	volatile bool* stop;
+};
+
+/* Keeps pushing and popping one value on top of the stack */
+static void* churnWorker(void* arg) {
+	SnapshotTask* task = static_cast<SnapshotTask*>(arg);
+	int value;
+
+	for (int i = 0; !*task->stop; ++i) {
+		task->stack->push(1000 + i);
+		task->stack->pop(value);
+	}
+	return NULL;
+}
+
+/* Under churn on the top, every snapshot must hold 0..base-1 in order, plus at most one value per writer */
+static bool checkSnapshots(int base, int writers, int snapshots) {
+	ConcurrentStack<int> stack;
+	volatile bool stop = false;
+	SnapshotTask task = { &stack, &stop };
+	std::vector<pthread_t> ids(writers);
+	bool consistent = true;
+
+	for (int i = 0; i < base; ++i)
+		stack.push(i);
+	for (int w = 0; w < writers; ++w)
+		pthread_create(&ids[w], NULL, churnWorker, &task);
+	for (int s = 0; s < snapshots && consistent; ++s) {
+		ConcurrentStack<int>::snapshot_type snap = stack.snapshot();
+		if (snap.size() < static_cast<std::size_t>(base) || snap.size() > static_cast<std::size_t>(base + writers))
+			consistent = false;
+		int expected = 0;
+		for (ConcurrentStack<int>::snapshot_type::const_iterator it = snap.begin(); it != snap.end() && expected < base; ++it)
+			if (*it != expected++)
+				consistent = false;
+	}
+	stop = true;
+	for (int w = 0; w < writers; ++w)
+		pthread_join(ids[w], NULL);
+	return consistent;
+}
+
+template <typename Stack>
+struct BenchTask {
+	Stack* stack;
+	int pairs;
+};
+
+/* pairs push/pop pairs: the shared work-stack pattern */
+template <typename Stack>
+static void* benchWorker(void* arg) {
+	BenchTask<Stack>* task = static_cast<BenchTask<Stack>*>(arg);
+	int value;
+
+	for (int i = 0; i < task->pairs; ++i) {
+		task->stack->push(i);
+		task->stack->pop(value);
+	}
+	return NULL;
+}
+
+/* Millions of operations (push or pop) per second over threads workers */
+template <typename Stack>
+static double benchSharedStack(int threads, int pairs) {
+	Stack stack;
+	BenchTask<Stack> task = { &stack, pairs };
+	std::vector<pthread_t> ids(threads);
+	double start = nowMs();
+
+	for (int t = 0; t < threads; ++t)
+		pthread_create(&ids[t], NULL, benchWorker<Stack>, &task);
+	for (int t = 0; t < threads; ++t)
+		pthread_join(ids[t], NULL);
+	return 2.0 * threads * pairs / ((nowMs() - start) * 1000.0);
+}
+
+struct DequeTask {
+	WorkStealingDeque<int>* deque;
+	volatile bool* stop;
+	std::vector<int> taken;
+};
+
+static void* thiefWorker(void* arg) {
+	DequeTask* task = static_cast<DequeTask*>(arg);
+	int value;
+
+	while (!*task->stop || !task->deque->empty())
+		if (task->deque->steal(value))
+			task->taken.push_back(value);
+	return NULL;
+}
+
+/* Owner pushes count values (popping one every third push) while thieves steal: each value taken once */
+static bool stressWorkStealing(int thieves, int count) {
+	WorkStealingDeque<int> deque(4);
+	volatile bool stop = false;
+	std::vector<DequeTask> tasks(thieves);
+	std::vector<pthread_t> ids(thieves);
+	std::vector<int> seen(count, 0);
+	int value;
+
+	for (int t = 0; t < thieves; ++t) {
+		tasks[t].deque = &deque;
+		tasks[t].stop = &stop;
+		pthread_create(&ids[t], NULL, thiefWorker, &tasks[t]);
+	}
+	for (int i = 0; i < count; ++i) {
+		deque.push(i);
+		if (i % 3 == 2 && deque.pop(value))
+			++seen[value];
+	}
+	while (deque.pop(value))
+		++seen[value];
+	stop = true;
+	for (int t = 0; t < thieves; ++t) {
+		pthread_join(ids[t], NULL);
+		for (std::size_t i = 0; i < tasks[t].taken.size(); ++i)
+			++seen[tasks[t].taken[i]];
+	}
+	for (int i = 0; i < count; ++i)
+		if (seen[i] != 1)
+			return false;
+	return true;
+}
+
+/* Fork-join recursive sum: each worker owns a deque of tasks and steals from the others when idle */
+struct SumTask {
+	const int* data;
+	std::size_t begin;
+	std::size_t end;
+	long long result;
+	volatile int done;
+};
+
+struct SumWorker {
+	WorkStealingDeque<SumTask*> deque;
+	std::vector<SumWorker*>* workers;
+	volatile bool* finished;
+	unsigned int id;
+	unsigned int seed;
+	unsigned long steals;
+};
+
+static const std::size_t SUM_CUTOFF = 4096;
+
+static bool findTask(SumWorker& worker, SumTask*& task) {
+	if (worker.deque.pop(task))
+		return true;
+
+	std::size_t count = worker.workers->size();
+	if (count < 2)
+		return false;
+	worker.seed ^= worker.seed << 13;
+	worker.seed ^= worker.seed >> 17;
+	worker.seed ^= worker.seed << 5;
+	unsigned int victim = worker.seed % (count - 1);
+	if (victim >= worker.id)
+		++victim;
+	if ((*worker.workers)[victim]->deque.steal(task)) {
+		++worker.steals;
+		return true;
+	}
+	return false;
+}
+
+/* Forks the right half onto the deque, recurses into the left one, then helps until the right half is done */
+static void runSum(SumWorker& worker, SumTask* task) {
+	if (task->end - task->begin <= SUM_CUTOFF) {
+		long long sum = 0;
+		for (std::size_t i = task->begin; i < task->end; ++i)
+			sum += task->data[i];
+		task->result = sum;
+	}
+	else {
+		std::size_t middle = task->begin + (task->end - task->begin) / 2;
+		SumTask left = { task->data, task->begin, middle, 0, 0 };
+		SumTask right = { task->data, middle, task->end, 0, 0 };
+		SumTask* other;
+
+		worker.deque.push(&right);
+		runSum(worker, &left);
+		while (!right.done) {
+			if (findTask(worker, other))
+				runSum(worker, other);
+			else
+				sched_yield();
+		}
+		task->result = left.result + right.result;
+	}
+	__sync_synchronize();
+	task->done = 1;
+}
+
+static void* sumWorker(void* arg) {
+	SumWorker* worker = static_cast<SumWorker*>(arg);
+	SumTask* task;
+
+	while (!*worker->finished) {
+		if (findTask(*worker, task))
+			runSum(*worker, task);
+		else
+			sched_yield();
+	}
+	return NULL;
+}
+
+/* Sums data[0, n) on threads workers (the calling thread is worker 0) */
+static long long parallelSum(const int* data, std::size_t n, unsigned int threads, unsigned long& steals) {
+	std::vector<SumWorker*> workers(threads);
+	std::vector<pthread_t> ids(threads);
+	volatile bool finished = false;
+	SumTask root = { data, 0, n, 0, 0 };
+
+	for (unsigned int w = 0; w < threads; ++w) {
+		workers[w] = new SumWorker();
+		workers[w]->workers = &workers;
+		workers[w]->finished = &finished;
+		workers[w]->id = w;
+		workers[w]->seed = 2463534242u + w;
+		workers[w]->steals = 0;
+	}
+	for (unsigned int w = 1; w < threads; ++w)
+		pthread_create(&ids[w], NULL, sumWorker, workers[w]);
+	runSum(*workers[0], &root);
+	finished = true;
+	steals = 0;
+	for (unsigned int w = 0; w < threads; ++w) {
+		if (w > 0)
+			pthread_join(ids[w], NULL);
+		steals += workers[w]->steals;
+		delete workers[w];
+	}
+	return root.result;
+}
 
 int main() {
 	{
@@ -68,6 +430,142 @@ int main() {
 			std::cout << *lit << std::endl;
 		}
 	}
+	{
+		std::cout << "\n=== Pluggable container ===" << std::endl;
+		MutantStack<int, SmallVector<int, 4> > small;
+		MutantStack<int, std::vector<int> > vec;
+
+		for (int i = 1; i <= 6; ++i) {
+			small.push(i * 10);
+			vec.push(i * 10);
+			if (i == 4 || i == 5) {
+				MutantStack<int, SmallVector<int, 4> >::const_iterator last = small.end();
+				std::cout << "SmallVector<int, 4> with " << small.size() << " elements, last "
+					<< *--last << std::endl;
+			}
+		}
+
+		std::cout << "Reverse iteration (SmallVector): ";
+		for (MutantStack<int, SmallVector<int, 4> >::reverse_iterator it = small.rbegin(); it != small.rend(); ++it)
+			std::cout << *it << " ";
+		std::cout << "\nForward iteration (vector):      ";
+		for (MutantStack<int, std::vector<int> >::iterator it = vec.begin(); it != vec.end(); ++it)
+			std::cout << *it << " ";
+		std::cout << std::endl;
+
+		MutantStack<int, SmallVector<int, 4> > copy(small);
+		copy.pop();
+		std::cout << "Copy popped once: top " << copy.top() << ", original top " << small.top()
+			<< ", copy < original: " << (copy < small ? "yes" : "no") << std::endl;
+
+		MutantStack<std::string, SmallVector<std::string, 2> > words;
+		words.push("inline");
+		words.push("storage");
+		words.push("spills");
+		std::cout << "Strings:";
+		for (MutantStack<std::string, SmallVector<std::string, 2> >::iterator it = words.begin(); it != words.end(); ++it)
+			std::cout << " " << *it;
+		std::cout << std::endl;
+
+		/* push(top()) at capacity: the pushed value lives in the storage being replaced */
+		MutantStack<std::string, SmallVector<std::string, 2> > echo;
+		echo.push("a string long enough to live on the heap");
+		echo.push(echo.top());
+		echo.push(echo.top());
+		echo.push(echo.top());
+		echo.push(echo.top());
+		std::cout << "push(top()) from inline and heap storage: "
+			<< (echo.size() == 5 && echo.top() == "a string long enough to live on the heap" ? "ok" : "FAILED")
+			<< std::endl;
+	}
+	{
+		std::cout << "\n=== Benchmark: 1000000 stacks of 8 elements ===" << std::endl;
+		double dequeMs = benchSmallStacks<MutantStack<int> >("std::deque (default)", 1000000, 8);
+		benchSmallStacks<MutantStack<int, std::vector<int> > >("std::vector         ", 1000000, 8);
+		double smallMs = benchSmallStacks<MutantStack<int, SmallVector<int, 16> > >("SmallVector<int, 16>", 1000000, 8);
+		std::cout << "  SmallVector speedup over deque: " << dequeMs / smallMs << "x" << std::endl;
+
+		std::cout << "\n=== Benchmark: one stack of 10000000 elements, 5 passes ===" << std::endl;
+		benchLargeStack<MutantStack<int> >("std::deque (default)", 10000000, 5);
+		benchLargeStack<MutantStack<int, std::vector<int> > >("std::vector         ", 10000000, 5);
+		benchLargeStack<MutantStack<int, SmallVector<int, 16> > >("SmallVector<int, 16>", 10000000, 5);
+	}
+	{
+		std::cout << "\n=== ConcurrentStack stress (values popped exactly once) ===" << std::endl;
+		for (int threads = 1; threads <= 64; threads *= 2)
+			std::cout << "  " << threads << " threads: "
+				<< (stressConcurrentStack(threads, 20000) ? "OK" : "FAILED") << std::endl;
+		std::cout << "  Snapshots under churn: " << (checkSnapshots(100, 4, 2000) ? "consistent" : "INCONSISTENT") << std::endl;
+
+		ConcurrentStack<int> shared;
+		for (int i = 1; i <= 5; ++i)
+			shared.push(i * 100);
+		ConcurrentStack<int> copy(shared);
+		int top = 0;
+		copy.pop(top);
+		ConcurrentStack<int>::snapshot_type snap = shared.snapshot();
+		std::cout << "  Snapshot of 5 pushes:";
+		for (ConcurrentStack<int>::snapshot_type::iterator it = snap.begin(); it != snap.end(); ++it)
+			std::cout << " " << *it;
+		std::cout << " (top " << snap.top() << "), copy popped " << top << std::endl;
+	}
+	{
+		std::cout << "\n=== Benchmark: shared stack, 200000 push/pop pairs per thread (Mops/s) ===" << std::endl;
+		for (int threads = 1; threads <= 8; threads *= 2) {
+			double lockFree = benchSharedStack<ConcurrentStack<int> >(threads, 200000);
+			double locked = benchSharedStack<LockedStack>(threads, 200000);
+			std::cout << "  " << threads << " threads: ConcurrentStack " << lockFree
+				<< ", mutex + MutantStack " << locked << std::endl;
+		}
+	}
+	{
+		std::cout << "\n=== WorkStealingDeque ===" << std::endl;
+		WorkStealingDeque<int> deque(2);
+		int value = 0;
+
+		for (int i = 1; i <= 5; ++i)
+			deque.push(i);
+		std::cout << "  Pushed 1..5 into capacity 2, grown to " << deque.capacity() << std::endl;
+		deque.steal(value);
+		std::cout << "  Stolen from the top: " << value;
+		deque.pop(value);
+		std::cout << ", popped from the bottom: " << value << std::endl;
+		WorkStealingDeque<int>::snapshot_type left = deque.snapshot();
+		std::cout << "  Remaining:";
+		for (WorkStealingDeque<int>::snapshot_type::const_iterator it = left.begin(); it != left.end(); ++it)
+			std::cout << " " << *it;
+		std::cout << std::endl;
+
+		for (int thieves = 1; thieves <= 8; thieves *= 2)
+			std::cout << "  Owner + " << thieves << " thieves: "
+				<< (stressWorkStealing(thieves, 200000) ? "OK" : "FAILED") << std::endl;
+	}
+	{
+		std::cout << "\n=== Benchmark: fork-join sum of 16777216 ints (cutoff " << SUM_CUTOFF << ") ===" << std::endl;
+		std::vector<int> data(1 << 24);
+		long long expected = 0;
+		for (std::size_t i = 0; i < data.size(); ++i) {
+			data[i] = static_cast<int>(i % 1000) - 500;
+			expected += data[i];
+		}
+
+		double start = nowMs();
+		long long sequential = 0;
+		for (std::size_t i = 0; i < data.size(); ++i)
+			sequential += data[i];
+		double sequentialMs = nowMs() - start;
+		std::cout << "  sequential loop: " << sequentialMs << " ms" << std::endl;
+
+		for (unsigned int threads = 1; threads <= 8; threads *= 2) {
+			unsigned long steals = 0;
+			start = nowMs();
+			long long sum = parallelSum(&data[0], data.size(), threads, steals);
+			double elapsed = nowMs() - start;
+			std::cout << "  " << threads << " workers: " << elapsed << " ms, speedup "
+				<< sequentialMs / elapsed << "x, " << steals << " steals, "
+				<< (sum == expected && sequential == expected ? "correct" : "WRONG") << std::endl;
+		}
+	}
 
 	return 0;
 }
@@ -0,0 +1,357 @@
+#include "Benchmark.hpp"
+#include "MergeInsertion.hpp"
+#include "Instrumentation.hpp"
+#include "Parallel.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+
+/* Sizes of the sweep: every n up to 16, then 1-2-5 steps per decade, then maxN */
+static std::vector<std::size_t>	benchmarkSizes(std::size_t maxN)
+{
+	std::vector<std::size_t>	sizes;
+	const std::size_t			steps[] = { 2, 5, 10 };
+
+	for (std::size_t n = 1; n <= maxN && n <= 16; ++n)
+		sizes.push_back(n);
+	for (std::size_t decade = 10; decade <= maxN; decade *= 10)
+	{
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			std::size_t n = decade * steps[i];
+			if (n > 16 && n <= maxN)
+				sizes.push_back(n);
+		}
+	}
+	if (sizes.empty() || sizes.back() != maxN)
+		sizes.push_back(maxN);
+	return sizes;
+}
+
+template <typename Container>
+static bool	isSorted(const Container& container)
+{
+	for (typename Container::const_iterator it = container.begin(); it != container.end(); ++it)
+	{
+		typename Container::const_iterator next = it;
+		if (++next != container.end() && *next < *it)
+			return false;
+	}
+	return true;
+}
+
+static void	writeRow(std::ostream& out, std::size_t n, const char* container,
+	const SortStats& stats, bool sorted)
+{
+	unsigned long	bound = comparisonLowerBound(n);
+	unsigned long	fordJohnson = fordJohnsonComparisons(n);
+
+	out << n << ',' << container << ','
+		<< stats.comparisons << ',' << bound << ',' << fordJohnson << ','
+		<< std::setprecision(4) << (bound ? static_cast<double>(stats.comparisons) / bound : 1.0) << ','
+		<< stats.moves << ','
+		<< std::setprecision(1)
+		<< stats.pairingUs << ',' << stats.recursionUs << ',' << stats.insertionUs << ','
+		<< stats.totalUs() << ','
+		<< (sorted ? "yes" : "no") << ','
+		<< (stats.comparisons <= fordJohnson ? "yes" : "no") << '\n';
+}
+
+/* Sorts a copy of the sequence held in Container and writes its CSV row */
+template <typename Container>
+static bool	benchmarkContainer(std::ostream& out, const std::vector<int>& sequence, const char* name)
+{
+	Container						container;
+	MergeInsertion<Container>		engine;
+
+	for (std::size_t i = 0; i < sequence.size(); ++i)
+		container.push_back(sequence[i]);
+	engine.sort(container);
+
+	bool sorted = isSorted(container) && container.size() == sequence.size();
+	writeRow(out, sequence.size(), name, engine.getStats(), sorted);
+	return sorted && engine.getStats().comparisons <= fordJohnsonComparisons(sequence.size());
+}
+
+/**
+ * @brief Runs the comparison/timing sweep and writes it as CSV
+ *
+ * The input of every size is a shuffled permutation of 1..n generated from a
+ * fixed seed, so two runs produce the same comparison counts. A row whose
+ * comparisons exceed the Ford-Johnson worst case is still written, with
+ * within_ford_johnson set to "no", and makes the run fail.
+ *
+ * @param maxN Largest sequence size of the sweep
+ * @param out Stream receiving the CSV
+ * @return int 0 if every sort was sorted and within the bound, 1 otherwise
+ */
+int	runBenchmark(std::size_t maxN, std::ostream& out)
+{
+	std::vector<std::size_t>	sizes = benchmarkSizes(maxN);
+	int							status = 0;
+
+	std::srand(42);
+	out << std::fixed;
+	out << "n,container,comparisons,lower_bound,ford_johnson,ratio,moves,"
+		<< "pairing_us,recursion_us,insertion_us,total_us,sorted,within_ford_johnson\n";
+
+	for (std::vector<std::size_t>::const_iterator size = sizes.begin(); size != sizes.end(); ++size)
+	{
+		std::vector<int>	sequence;
+
+		for (std::size_t i = 1; i <= *size; ++i)
+			sequence.push_back(static_cast<int>(i));
+		std::random_shuffle(sequence.begin(), sequence.end());
+
+		if (!benchmarkContainer<std::deque<int> >(out, sequence, "deque"))
+			status = 1;
+		if (!benchmarkContainer<std::vector<int> >(out, sequence, "vector"))
+			status = 1;
+		if (!benchmarkContainer<ChunkedVector<int> >(out, sequence, "chunked"))
+			status = 1;
+		out.flush();
+	}
+	return status;
+}
+
+/* A record of the sorting pipeline: ordered by key, the payload travels along */
+struct Record
+{
+	long long	key;
+	int			payload;
+};
+
+struct RecordKeyLess
+{
+	bool operator()(const Record& a, const Record& b) const { return a.key < b.key; }
+};
+
+template <typename Container, typename Compare>
+static bool	isSortedBy(const Container& container, Compare compare)
+{
+	for (std::size_t i = 1; i < container.size(); ++i)
+	{
+		if (compare(container[i], container[i - 1]))
+			return false;
+	}
+	return true;
+}
+
+static void	reportCheck(std::ostream& out, const char* name, bool ok, int& status)
+{
+	out << (ok ? "OK  " : "FAIL") << ' ' << name << '\n';
+	if (!ok)
+		status = 1;
+}
+
+/* Sorts every permutation of 1..n, each one must be sorted and within Ford-Johnson */
+static bool	checkPermutations(std::size_t n, std::size_t smallThreshold)
+{
+	std::vector<int>	permutation;
+
+	for (std::size_t i = 1; i <= n; ++i)
+		permutation.push_back(static_cast<int>(i));
+	do
+	{
+		std::vector<int>					container(permutation);
+		MergeInsertion<std::vector<int> >	engine;
+
+		engine.setSmallThreshold(smallThreshold);
+		engine.sort(container);
+		if (!isSorted(container) || engine.getStats().comparisons > fordJohnsonComparisons(n))
+			return false;
+	} while (std::next_permutation(permutation.begin(), permutation.end()));
+	return true;
+}
+
+/**
+ * @brief Sorts 64-bit keys and key/payload records with the generic engine
+ *
+ * Keys are spread above 2^32 so a truncation to int would show up as a wrong
+ * order; every record's payload encodes its key, so a lost or mixed payload
+ * is detected after sorting.
+ *
+ * @param out Stream receiving one OK/FAIL line per check
+ * @return int 0 if every check passed, 1 otherwise
+ */
+int	runEngineChecks(std::ostream& out)
+{
+	const std::size_t	n = 1000;
+	int					status = 0;
+
+	std::srand(42);
+
+	std::vector<long long>	wide;
+	for (std::size_t i = 0; i < n; ++i)
+		wide.push_back((static_cast<long long>(std::rand()) << 32) - static_cast<long long>(i));
+
+	MergeInsertion<std::vector<long long> >	wideEngine;
+	wideEngine.sort(wide);
+	reportCheck(out, "vector<long long>", isSortedBy(wide, std::less<long long>())
+		&& wideEngine.getStats().comparisons <= fordJohnsonComparisons(n), status);
+
+	std::deque<Record>			records;
+	ChunkedVector<Record>		chunkedRecords;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		Record	record;
+		record.key = static_cast<long long>(std::rand() % 5000) * 1000000007LL;
+		record.payload = static_cast<int>(record.key / 1000000007LL);
+		records.push_back(record);
+		chunkedRecords.push_back(record);
+	}
+
+	MergeInsertion<std::deque<Record>, RecordKeyLess>		recordEngine;
+	MergeInsertion<ChunkedVector<Record>, RecordKeyLess>	chunkedEngine;
+	recordEngine.sort(records);
+	chunkedEngine.sort(chunkedRecords);
+
+	bool	payloadsKept = true;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (records[i].payload != records[i].key / 1000000007LL
+			|| chunkedRecords[i].payload != chunkedRecords[i].key / 1000000007LL)
+			payloadsKept = false;
+	}
+	reportCheck(out, "deque<Record> by key", isSortedBy(records, RecordKeyLess()) && payloadsKept
+		&& recordEngine.getStats().comparisons <= fordJohnsonComparisons(n), status);
+	reportCheck(out, "ChunkedVector<Record> by key", isSortedBy(chunkedRecords, RecordKeyLess())
+		&& chunkedEngine.getStats().comparisons <= fordJohnsonComparisons(n), status);
+
+	reportCheck(out, "every permutation of 8, small-n kernel", checkPermutations(8, 16), status);
+	reportCheck(out, "every permutation of 8, pure recursion", checkPermutations(8, 0), status);
+	return status;
+}
+
+/* One run of the parallel sweep; threads == 0 is the sequential path */
+static bool	timeParallelRun(std::ostream& out, const std::vector<int>& sequence, std::size_t threads,
+	double& baselineUs)
+{
+	std::vector<int>					container(sequence);
+	MergeInsertion<std::vector<int> >	engine;
+
+	engine.setThreads(threads);
+	double start = monotonicMicroseconds();
+	engine.sort(container);
+	double elapsedUs = monotonicMicroseconds() - start;
+
+	if (threads == 1)
+		baselineUs = elapsedUs;
+	bool sorted = isSorted(container);
+	out << (threads ? "parallel" : "sequential") << ',' << threads << ','
+		<< std::setprecision(1) << elapsedUs << ','
+		<< std::setprecision(3) << (threads && elapsedUs > 0 ? baselineUs / elapsedUs : 0.0) << ','
+		<< engine.getStats().comparisons << ',' << (sorted ? "yes" : "no") << '\n';
+	out.flush();
+	return sorted;
+}
+
+/**
+ * @brief Measures the parallel path for growing thread counts
+ *
+ * The speedup column is relative to the parallel path on one thread, so it
+ * only reflects the threads; the sequential row shows what the parallel path
+ * costs or saves as an algorithm (one merge per Jacobsthal group instead of
+ * one shift per inserted element, a few comparisons above Ford-Johnson).
+ *
+ * @param n Size of the permutation to sort
+ * @param out Stream receiving the CSV
+ * @return int 0 if every run produced a sorted sequence, 1 otherwise
+ */
+int	runParallelBenchmark(std::size_t n, std::ostream& out)
+{
+	std::vector<int>	sequence;
+	std::size_t			maxThreads = hardwareThreads();
+	double				baselineUs = 0;
+	int					status = 0;
+
+	if (maxThreads < 2)
+		maxThreads = 2;
+	for (std::size_t i = 1; i <= n; ++i)
+		sequence.push_back(static_cast<int>(i));
+	std::srand(42);
+	std::random_shuffle(sequence.begin(), sequence.end());
+
+	out << std::fixed;
+	out << "mode,threads,total_us,speedup,comparisons,sorted\n";
+	if (!timeParallelRun(out, sequence, 0, baselineUs))
+		status = 1;
+	for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		if (!timeParallelRun(out, sequence, threads, baselineUs))
+			status = 1;
+		if (threads < maxThreads && threads * 2 > maxThreads
+			&& !timeParallelRun(out, sequence, maxThreads, baselineUs))
+			status = 1;
+	}
+	return status;
+}
+
+/* Sorts `runs` shuffled permutations of 1..size with one threshold and writes its row */
+static bool	timeKernelRun(std::ostream& out, std::size_t threshold, std::size_t size, std::size_t runs)
+{
+	std::vector<int>	sequence;
+	unsigned long		comparisons = 0;
+	double				elapsedUs = 0;
+	bool				ok = true;
+
+	for (std::size_t i = 1; i <= size; ++i)
+		sequence.push_back(static_cast<int>(i));
+	std::srand(42);
+	for (std::size_t run = 0; run < runs; ++run)
+	{
+		std::random_shuffle(sequence.begin(), sequence.end());
+
+		std::vector<int>					container(sequence);
+		MergeInsertion<std::vector<int> >	engine;
+
+		engine.setSmallThreshold(threshold);
+		double start = monotonicMicroseconds();
+		engine.sort(container);
+		elapsedUs += monotonicMicroseconds() - start;
+
+		comparisons += engine.getStats().comparisons;
+		if (!isSorted(container) || engine.getStats().comparisons > fordJohnsonComparisons(size))
+			ok = false;
+	}
+	out << threshold << ',' << size << ',' << runs << ','
+		<< std::setprecision(1) << elapsedUs << ','
+		<< comparisons << ',' << (ok ? "yes" : "no") << '\n';
+	out.flush();
+	return ok;
+}
+
+/**
+ * @brief Measures the small-n kernel against the pure recursion
+ *
+ * Every size is sorted in batches of about 200000 elements in total, so the
+ * small sizes, where the kernel replaces the whole recursion, are measured
+ * over many runs. Both paths run the same comparisons: only the time differs.
+ *
+ * @param n Largest size of the sweep
+ * @param out Stream receiving the CSV
+ * @return int 0 if every run was sorted and within the bound, 1 otherwise
+ */
+int	runKernelBenchmark(std::size_t n, std::ostream& out)
+{
+	const std::size_t	thresholds[] = { 0, 4, 8, 16 };
+	const std::size_t	sizes[] = { 8, 16, 1000, n };
+	int					status = 0;
+
+	out << std::fixed;
+	out << "threshold,n,runs,total_us,comparisons,within_ford_johnson\n";
+	for (std::size_t s = 0; s < 4; ++s)
+	{
+		if (s == 3 && (n <= sizes[2]))
+			break;
+		std::size_t	runs = (sizes[s] < 200000) ? 200000 / sizes[s] : 1;
+
+		for (std::size_t t = 0; t < 4; ++t)
+		{
+			if (!timeKernelRun(out, thresholds[t], sizes[s], runs))
+				status = 1;
+		}
+	}
+	return status;
+}
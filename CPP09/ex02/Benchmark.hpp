@@ -0,0 +1,46 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+#include <ostream>
+
+/**
+ * Instrumented mode: sorts shuffled permutations of 1..n with every container
+ * for n = 1..16 and then 20, 50, 100, 200, 500, ... up to maxN, and writes one
+ * CSV row per (n, container) with comparisons, moves and stage timings.
+ * Containers: std::deque, std::vector and ChunkedVector.
+ *
+ * Returns 0 if every run produced a sorted sequence, 1 otherwise.
+ */
+int	runBenchmark(std::size_t maxN, std::ostream& out);
+
+/**
+ * Sorts non-int element types with the generic engine (64-bit keys, records
+ * carrying a payload with a key comparator) and reports whether each result is
+ * sorted, keeps every payload and stays within the Ford-Johnson bound.
+ *
+ * Returns 0 if every check passed, 1 otherwise.
+ */
+int	runEngineChecks(std::ostream& out);
+
+/**
+ * Sorts one shuffled permutation of 1..n with std::vector, first with the
+ * sequential path and then with the parallel path on 1, 2, 4, ... threads (up
+ * to the number of online processors, at least 2), and writes one CSV row per
+ * run with its time and its speedup over the 1-thread parallel run.
+ *
+ * Returns 0 if every run produced a sorted sequence, 1 otherwise.
+ */
+int	runParallelBenchmark(std::size_t n, std::ostream& out);
+
+/**
+ * Compares the small-n kernel with the pure recursion: for thresholds 0 (pure
+ * recursion), 4, 8 and 16, sorts batches of shuffled permutations of 8, 16,
+ * 1000 and n elements with std::vector and writes one CSV row per (threshold,
+ * size) with the time of the batch and its comparisons.
+ *
+ * Returns 0 if every run was sorted and within the Ford-Johnson bound, 1 otherwise.
+ */
+int	runKernelBenchmark(std::size_t n, std::ostream& out);
+
+#endif
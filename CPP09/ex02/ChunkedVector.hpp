@@ -0,0 +1,128 @@
+#ifndef CHUNKEDVECTOR_HPP
+#define CHUNKEDVECTOR_HPP
+
+#include <vector>
+#include <cstddef>
+#include <iterator>
+
+/**
+ * ChunkedVector: a sequence stored as a list of small contiguous chunks
+ *
+ * Each chunk holds at most 2 * CHUNK_SIZE elements; a full chunk is split in
+ * two. Inserting in the middle only shifts the elements of one chunk (plus one
+ * offset per following chunk) instead of the whole tail like std::vector, while
+ * elements stay contiguous inside a chunk, unlike the fixed tiny blocks of
+ * std::deque. Random access is a binary search over the chunk offsets, with a
+ * shortcut for the chunk accessed last (sequential scans never search).
+ */
+template <typename T>
+class ChunkedVector
+{
+public:
+	typedef T					value_type;
+	typedef std::size_t			size_type;
+	typedef std::ptrdiff_t		difference_type;
+	typedef T&					reference;
+	typedef const T&			const_reference;
+
+	static const size_type	CHUNK_SIZE = 512;
+
+	/* Random access iterator: a container pointer plus an index */
+	template <typename Ref, typename Ptr, typename Owner>
+	class Iterator
+	{
+	public:
+		typedef std::random_access_iterator_tag	iterator_category;
+		typedef T								value_type;
+		typedef std::ptrdiff_t					difference_type;
+		typedef Ptr								pointer;
+		typedef Ref								reference;
+
+		Iterator() : _owner(NULL), _index(0) {}
+		Iterator(Owner* owner, size_type index) : _owner(owner), _index(index) {}
+		template <typename R, typename P, typename O>
+		Iterator(const Iterator<R, P, O>& other) : _owner(other.owner()), _index(other.index()) {}
+
+		reference	operator*() const { return (*_owner)[_index]; }
+		pointer		operator->() const { return &(*_owner)[_index]; }
+		reference	operator[](difference_type n) const { return (*_owner)[_index + n]; }
+
+		Iterator&	operator++() { ++_index; return *this; }
+		Iterator&	operator--() { --_index; return *this; }
+		Iterator	operator++(int) { Iterator tmp(*this); ++_index; return tmp; }
+		Iterator	operator--(int) { Iterator tmp(*this); --_index; return tmp; }
+		Iterator&	operator+=(difference_type n) { _index += n; return *this; }
+		Iterator&	operator-=(difference_type n) { _index -= n; return *this; }
+		Iterator	operator+(difference_type n) const { return Iterator(_owner, _index + n); }
+		Iterator	operator-(difference_type n) const { return Iterator(_owner, _index - n); }
+		difference_type	operator-(const Iterator& other) const
+		{
+			return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+		}
+
+		bool	operator==(const Iterator& other) const { return _index == other._index; }
+		bool	operator!=(const Iterator& other) const { return _index != other._index; }
+		bool	operator<(const Iterator& other) const { return _index < other._index; }
+		bool	operator>(const Iterator& other) const { return _index > other._index; }
+		bool	operator<=(const Iterator& other) const { return _index <= other._index; }
+		bool	operator>=(const Iterator& other) const { return _index >= other._index; }
+
+		Owner*		owner() const { return _owner; }
+		size_type	index() const { return _index; }
+
+	private:
+		Owner*		_owner;
+		size_type	_index;
+	};
+
+	typedef Iterator<T&, T*, ChunkedVector>							iterator;
+	typedef Iterator<const T&, const T*, const ChunkedVector>		const_iterator;
+
+	/*** constructor ***/
+	ChunkedVector();
+	/*** copy constructor ***/
+	ChunkedVector(const ChunkedVector& other);
+	/*** assignment operator ***/
+	ChunkedVector& operator=(const ChunkedVector& other);
+	/*** destructor ***/
+	~ChunkedVector();
+
+	size_type	size() const;
+	bool		empty() const;
+	void		clear();
+	void		swap(ChunkedVector& other);
+
+	reference		operator[](size_type index);
+	const_reference	operator[](size_type index) const;
+	reference		back();
+	const_reference	back() const;
+
+	void		push_back(const T& value);
+	void		pop_back();
+	iterator	insert(iterator pos, const T& value);
+
+	iterator		begin();
+	iterator		end();
+	const_iterator	begin() const;
+	const_iterator	end() const;
+
+private:
+	typedef std::vector<T>	Chunk;
+
+	/* chunks are held by pointer so that splitting one never copies the others */
+	std::vector<Chunk*>		_chunks;
+	std::vector<size_type>	_offsets;
+	size_type				_size;
+	mutable size_type		_lastChunk;
+
+	size_type	locate(size_type index) const;
+	void		splitChunk(size_type chunk);
+};
+
+template <typename T>
+void	swap(ChunkedVector<T>& a, ChunkedVector<T>& b) { a.swap(b); }
+
+/* Include the implementation file */
+#include "ChunkedVector.tpp"
+
+#endif
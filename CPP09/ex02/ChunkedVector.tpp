@@ -0,0 +1,213 @@
+#ifndef CHUNKEDVECTOR_TPP
+#define CHUNKEDVECTOR_TPP
+
+#include "ChunkedVector.hpp"
+#include <algorithm>
+
+/*** constructor ***/
+template <typename T>
+ChunkedVector<T>::ChunkedVector() : _size(0), _lastChunk(0) {}
+
+/*** copy constructor ***/
+template <typename T>
+ChunkedVector<T>::ChunkedVector(const ChunkedVector& other) : _size(0), _lastChunk(0)
+{
+	*this = other;
+}
+
+/*** assignment operator ***/
+template <typename T>
+ChunkedVector<T>& ChunkedVector<T>::operator=(const ChunkedVector& other)
+{
+	if (this != &other)
+	{
+		ChunkedVector	copy;
+
+		for (size_type i = 0; i < other._chunks.size(); ++i)
+		{
+			copy._chunks.push_back(new Chunk(*other._chunks[i]));
+			copy._offsets.push_back(other._offsets[i]);
+		}
+		copy._size = other._size;
+		swap(copy);
+	}
+	return *this;
+}
+
+/*** destructor ***/
+template <typename T>
+ChunkedVector<T>::~ChunkedVector()
+{
+	clear();
+}
+
+template <typename T>
+typename ChunkedVector<T>::size_type	ChunkedVector<T>::size() const { return _size; }
+
+template <typename T>
+bool	ChunkedVector<T>::empty() const { return _size == 0; }
+
+template <typename T>
+void	ChunkedVector<T>::clear()
+{
+	for (size_type i = 0; i < _chunks.size(); ++i)
+		delete _chunks[i];
+	_chunks.clear();
+	_offsets.clear();
+	_size = 0;
+	_lastChunk = 0;
+}
+
+template <typename T>
+void	ChunkedVector<T>::swap(ChunkedVector& other)
+{
+	_chunks.swap(other._chunks);
+	_offsets.swap(other._offsets);
+	std::swap(_size, other._size);
+	std::swap(_lastChunk, other._lastChunk);
+}
+
+/**
+ * @brief Finds the chunk holding the element at a given index
+ *
+ * The chunk found last is checked first, so scanning the sequence in order
+ * costs O(1) per element; otherwise the offsets are binary searched.
+ *
+ * @param index Position in the sequence, must be < size()
+ * @return size_type Index of the chunk holding it
+ */
+template <typename T>
+typename ChunkedVector<T>::size_type	ChunkedVector<T>::locate(size_type index) const
+{
+	/* chunk c holds [offsets[c], offsets[c + 1]), the last one up to _size */
+	const size_type*	offsets = &_offsets[0];
+	const size_type		count = _offsets.size();
+	const size_type		last = _lastChunk;
+
+	if (last < count && index >= offsets[last] && (last + 1 == count || index < offsets[last + 1]))
+		return last;
+	if (last + 1 < count && index >= offsets[last + 1] && (last + 2 == count || index < offsets[last + 2]))
+		return (_lastChunk = last + 1);
+
+	/* otherwise the last chunk whose offset is <= index */
+	size_type			low = 0;
+	size_type			length = count;
+
+	while (length > 1)
+	{
+		size_type	half = length / 2;
+
+		if (offsets[low + half] <= index)
+			low += half;
+		length -= half;
+	}
+	_lastChunk = low;
+	return _lastChunk;
+}
+
+template <typename T>
+typename ChunkedVector<T>::reference	ChunkedVector<T>::operator[](size_type index)
+{
+	size_type	chunk = locate(index);
+	return (*_chunks[chunk])[index - _offsets[chunk]];
+}
+
+template <typename T>
+typename ChunkedVector<T>::const_reference	ChunkedVector<T>::operator[](size_type index) const
+{
+	size_type	chunk = locate(index);
+	return (*_chunks[chunk])[index - _offsets[chunk]];
+}
+
+template <typename T>
+typename ChunkedVector<T>::reference	ChunkedVector<T>::back() { return _chunks.back()->back(); }
+
+template <typename T>
+typename ChunkedVector<T>::const_reference	ChunkedVector<T>::back() const { return _chunks.back()->back(); }
+
+template <typename T>
+void	ChunkedVector<T>::push_back(const T& value)
+{
+	if (_chunks.empty() || _chunks.back()->size() >= CHUNK_SIZE)
+	{
+		_chunks.push_back(new Chunk());
+		_chunks.back()->reserve(CHUNK_SIZE);
+		_offsets.push_back(_size);
+	}
+	_chunks.back()->push_back(value);
+	++_size;
+}
+
+template <typename T>
+void	ChunkedVector<T>::pop_back()
+{
+	_chunks.back()->pop_back();
+	--_size;
+	if (_chunks.back()->empty())
+	{
+		delete _chunks.back();
+		_chunks.pop_back();
+		_offsets.pop_back();
+		_lastChunk = 0;
+	}
+}
+
+/**
+ * @brief Inserts a value before pos
+ *
+ * Only the target chunk is shifted; the offsets of the following chunks are
+ * bumped by one. A chunk reaching 2 * CHUNK_SIZE elements is split in two.
+ *
+ * @param pos Position before which the value is inserted (end() appends)
+ * @param value The value to insert
+ * @return iterator Iterator to the inserted value
+ */
+template <typename T>
+typename ChunkedVector<T>::iterator	ChunkedVector<T>::insert(iterator pos, const T& value)
+{
+	size_type	index = pos.index();
+
+	if (index == _size)
+	{
+		push_back(value);
+		return iterator(this, index);
+	}
+
+	size_type	chunk = locate(index);
+	Chunk&		target = *_chunks[chunk];
+
+	target.insert(target.begin() + (index - _offsets[chunk]), value);
+	for (size_type i = chunk + 1; i < _offsets.size(); ++i)
+		++_offsets[i];
+	++_size;
+	if (target.size() >= 2 * CHUNK_SIZE)
+		splitChunk(chunk);
+	return iterator(this, index);
+}
+
+/* Moves the upper half of a chunk into a new chunk placed right after it */
+template <typename T>
+void	ChunkedVector<T>::splitChunk(size_type chunk)
+{
+	Chunk&	full = *_chunks[chunk];
+	Chunk*	upper = new Chunk(full.begin() + full.size() / 2, full.end());
+
+	upper->reserve(2 * CHUNK_SIZE);
+	full.resize(full.size() / 2);
+	_chunks.insert(_chunks.begin() + chunk + 1, upper);
+	_offsets.insert(_offsets.begin() + chunk + 1, _offsets[chunk] + full.size());
+}
+
+template <typename T>
+typename ChunkedVector<T>::iterator	ChunkedVector<T>::begin() { return iterator(this, 0); }
+
+template <typename T>
+typename ChunkedVector<T>::iterator	ChunkedVector<T>::end() { return iterator(this, _size); }
+
+template <typename T>
+typename ChunkedVector<T>::const_iterator	ChunkedVector<T>::begin() const { return const_iterator(this, 0); }
+
+template <typename T>
+typename ChunkedVector<T>::const_iterator	ChunkedVector<T>::end() const { return const_iterator(this, _size); }
+
+#endif
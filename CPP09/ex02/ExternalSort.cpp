@@ -0,0 +1,389 @@
+#include "ExternalSort.hpp"
+#include "IntegerReader.hpp"
+#include "OutputBuffer.hpp"
+#include "MergeInsertion.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+/* --- Run files --- */
+
+/* Anonymous temporary file, removed by the system once closed */
+static std::FILE*	createRunFile()
+{
+	std::FILE*	file = std::tmpfile();
+
+	if (file == NULL)
+		throw std::runtime_error("Error: could not create a temporary run file");
+	return file;
+}
+
+static void	closeAll(std::vector<std::FILE*>& files)
+{
+	for (std::size_t i = 0; i < files.size(); ++i)
+		std::fclose(files[i]);
+	files.clear();
+}
+
+/* Reads a binary run back one block at a time */
+class RunReader
+{
+public:
+	RunReader(std::FILE* file, std::size_t blockSize)
+		: _file(file), _block(blockSize), _position(0), _length(0), _value(0), _done(false)
+	{
+		advance();
+	}
+
+	bool	done() const { return _done; }
+	int		value() const { return _value; }
+
+	void	advance()
+	{
+		if (_position == _length)
+		{
+			_position = 0;
+			_length = std::fread(&_block[0], sizeof(int), _block.size(), _file);
+			if (_length == 0)
+			{
+				if (std::ferror(_file))
+					throw std::runtime_error("Error: could not read a temporary run file");
+				_done = true;
+				return;
+			}
+		}
+		_value = _block[_position++];
+	}
+
+private:
+	std::FILE*			_file;
+	std::vector<int>	_block;
+	std::size_t			_position;
+	std::size_t			_length;
+	int					_value;
+	bool				_done;
+};
+
+/**
+ * Loser tree over k runs: node n < k holds the loser of the match between
+ * its children 2n and 2n + 1 (leaf i sits at k + i), node 0 the overall
+ * winner. Replacing the winner replays one leaf-to-root path: log2(k)
+ * comparisons, against 2 log2(k) for a binary heap.
+ */
+class LoserTree
+{
+public:
+	explicit LoserTree(std::vector<RunReader>& runs) : _runs(runs), _tree(runs.size())
+	{
+		const std::size_t			k = runs.size();
+		std::vector<std::size_t>	winners(2 * k);
+
+		for (std::size_t n = 2 * k - 1; n > 0; --n)
+		{
+			if (n >= k)
+			{
+				winners[n] = n - k;
+				continue;
+			}
+
+			std::size_t	a = winners[2 * n];
+			std::size_t	b = winners[2 * n + 1];
+
+			winners[n] = beats(b, a) ? b : a;
+			_tree[n] = beats(b, a) ? a : b;
+		}
+		_tree[0] = winners[1];
+	}
+
+	/* Run holding the smallest current value (done() once every run is) */
+	RunReader&	top() { return _runs[_tree[0]]; }
+
+	/* Restores the tree after top() was advanced */
+	void	replay()
+	{
+		std::size_t	winner = _tree[0];
+
+		for (std::size_t n = (winner + _runs.size()) / 2; n > 0; n /= 2)
+		{
+			if (beats(_tree[n], winner))
+				std::swap(_tree[n], winner);
+		}
+		_tree[0] = winner;
+	}
+
+private:
+	std::vector<RunReader>&		_runs;
+	std::vector<std::size_t>	_tree;
+
+	/* An exhausted run loses against everything */
+	bool	beats(std::size_t a, std::size_t b) const
+	{
+		if (_runs[a].done())
+			return false;
+		if (_runs[b].done())
+			return true;
+		return _runs[a].value() < _runs[b].value();
+	}
+};
+
+/* Final output: one value per line through an OutputBuffer */
+class TextSink
+{
+public:
+	explicit TextSink(std::FILE* file) : _out(file) {}
+
+	void	write(int value)
+	{
+		_out.write(value);
+		_out.write('\n');
+	}
+
+private:
+	OutputBuffer	_out;
+};
+
+/* Intermediate run: binary values written one block at a time (flush() writes the last one) */
+class BinarySink
+{
+public:
+	BinarySink(std::FILE* file, std::size_t blockSize) : _file(file), _blockSize(blockSize)
+	{
+		_block.reserve(blockSize);
+	}
+
+	void	write(int value)
+	{
+		_block.push_back(value);
+		if (_block.size() == _blockSize)
+			flush();
+	}
+
+	void	flush()
+	{
+		if (!_block.empty() && std::fwrite(&_block[0], sizeof(int), _block.size(), _file) != _block.size())
+			throw std::runtime_error("Error: could not write a temporary run file");
+		_block.clear();
+	}
+
+private:
+	std::FILE*			_file;
+	std::size_t			_blockSize;
+	std::vector<int>	_block;
+};
+
+/* Drains the tree into the sink, rejecting a value equal to the previous one */
+template <typename Sink>
+static void	drain(LoserTree& tree, Sink& sink)
+{
+	bool	first = true;
+	int		previous = 0;
+
+	while (!tree.top().done())
+	{
+		int	value = tree.top().value();
+
+		if (!first && value == previous)
+			throw std::runtime_error("Error: Duplicate values are not allowed");
+		first = false;
+		previous = value;
+		sink.write(value);
+		tree.top().advance();
+		tree.replay();
+	}
+}
+
+/* --- Canonical Form --- */
+
+const std::size_t	ExternalSort::DEFAULT_RUN_SIZE;
+const std::size_t	ExternalSort::MAX_FAN_IN;
+const std::size_t	ExternalSort::MIN_BLOCK_SIZE;
+
+/* Constructor */
+ExternalSort::ExternalSort() : _runSize(DEFAULT_RUN_SIZE), _runs(0), _mergePasses(0), _files() {}
+
+/* Parameterized Constructor */
+ExternalSort::ExternalSort(std::size_t runSize)
+	: _runSize(runSize > 1 ? runSize : 2), _runs(0), _mergePasses(0), _files() {}
+
+/* Destructor */
+ExternalSort::~ExternalSort()
+{
+	closeFiles();
+}
+
+std::size_t	ExternalSort::getRuns() const
+{
+	return _runs;
+}
+
+std::size_t	ExternalSort::getMergePasses() const
+{
+	return _mergePasses;
+}
+
+void	ExternalSort::closeFiles()
+{
+	closeAll(_files);
+}
+
+/**
+ * @brief Sorts a text file of positive ints, writing them one per line
+ *
+ * A single run never touches the disk: it is sorted and written directly.
+ *
+ * @param input Whitespace-separated positive integers
+ * @param output Receives the sorted values, one per line
+ * @return std::size_t The number of values sorted
+ * @throws std::runtime_error On invalid or repeated input, or on an I/O error
+ */
+std::size_t	ExternalSort::sort(std::FILE* input, std::FILE* output)
+{
+	std::size_t	count = 0;
+
+	closeFiles();
+	_runs = 0;
+	_mergePasses = 0;
+	try
+	{
+		IntegerReader		reader(input);
+		std::vector<int>	run;
+		int					value;
+
+		run.reserve(_runSize);
+		while (reader.next(value))
+		{
+			run.push_back(value);
+			++count;
+			if (run.size() == _runSize)
+			{
+				sortRun(run);
+				spill(run);
+				run.clear();
+			}
+		}
+		if (!run.empty())
+			sortRun(run);
+		if (_files.empty())
+		{
+			OutputBuffer	out(output);
+
+			for (std::size_t i = 0; i < run.size(); ++i)
+			{
+				out.write(run[i]);
+				out.write('\n');
+			}
+			_runs = run.empty() ? 0 : 1;
+			return count;
+		}
+		if (!run.empty())
+			spill(run);
+		std::vector<int>().swap(run);
+
+		while (_files.size() > MAX_FAN_IN)
+		{
+			std::vector<std::FILE*>	pending;
+
+			pending.swap(_files);
+			try
+			{
+				for (std::size_t first = 0; first < pending.size(); first += MAX_FAN_IN)
+				{
+					std::size_t					last = std::min(first + MAX_FAN_IN, pending.size());
+					std::vector<std::FILE*>		group(pending.begin() + first, pending.begin() + last);
+					std::FILE*					merged = createRunFile();
+
+					_files.push_back(merged);
+					merge(group, merged, false);
+					std::rewind(merged);
+				}
+			}
+			catch (...)
+			{
+				closeAll(pending);
+				throw;
+			}
+			closeAll(pending);
+			++_mergePasses;
+		}
+		merge(_files, output, true);
+		++_mergePasses;
+	}
+	catch (...)
+	{
+		closeFiles();
+		throw;
+	}
+	closeFiles();
+	return count;
+}
+
+/*
+ * Sorts one run in memory, rejecting duplicates inside it.
+ *
+ * setThreads(1) selects the group-merge insertion of the parallel path on
+ * the calling thread alone (parallelFor starts no worker for one thread).
+ * A run only has to come out sorted, so the few comparisons it makes above
+ * the Ford-Johnson count do not matter. At the default run size of 2^20 it
+ * sorts about 4x faster than the exact sequential insertion, which pays a
+ * chunk lookup on every probe of its search and one chunk insert per element.
+ */
+void	ExternalSort::sortRun(std::vector<int>& run) const
+{
+	MergeInsertion<std::vector<int> >	engine;
+
+	engine.setThreads(1);
+	engine.sort(run);
+	for (std::size_t i = 1; i < run.size(); ++i)
+	{
+		if (run[i] == run[i - 1])
+			throw std::runtime_error("Error: Duplicate values are not allowed");
+	}
+}
+
+/* Writes a sorted run to a new temporary file with one fwrite */
+void	ExternalSort::spill(const std::vector<int>& run)
+{
+	std::FILE*	file = createRunFile();
+
+	_files.push_back(file);
+	if (std::fwrite(&run[0], sizeof(int), run.size(), file) != run.size())
+		throw std::runtime_error("Error: could not write a temporary run file");
+	std::rewind(file);
+	++_runs;
+}
+
+/**
+ * @brief Merges sorted binary runs with a loser tree
+ *
+ * The runSize values of memory are split between the read buffers of the
+ * runs (at least MIN_BLOCK_SIZE each) so the merge needs no more memory than
+ * sorting a run did.
+ *
+ * @param runs Sorted binary runs, positioned at their start
+ * @param output Receives the merged values
+ * @param text true for the final output (one value per line), false for a binary run
+ */
+void	ExternalSort::merge(const std::vector<std::FILE*>& runs, std::FILE* output, bool text)
+{
+	const std::size_t		blockSize = std::max(MIN_BLOCK_SIZE, _runSize / (runs.size() + 1));
+	std::vector<RunReader>	readers;
+
+	readers.reserve(runs.size());
+	for (std::size_t i = 0; i < runs.size(); ++i)
+		readers.push_back(RunReader(runs[i], blockSize));
+
+	LoserTree	tree(readers);
+
+	if (text)
+	{
+		TextSink	sink(output);
+
+		drain(tree, sink);
+	}
+	else
+	{
+		BinarySink	sink(output, blockSize);
+
+		drain(tree, sink);
+		sink.flush();
+	}
+}
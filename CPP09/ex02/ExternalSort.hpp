@@ -0,0 +1,61 @@
+#ifndef EXTERNALSORT_HPP
+#define EXTERNALSORT_HPP
+
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+
+/**
+ * ExternalSort: sorts a text file of positive ints larger than memory
+ *
+ * The input is read by IntegerReader in runs of runSize values; each run is
+ * sorted in memory with the merge-insertion engine and spilled, in binary, to
+ * an anonymous temporary file. The runs are then merged with a loser tree,
+ * MAX_FAN_IN at a time (extra passes write merged runs back to temporary
+ * files), and the last pass writes the values, one per line, through an
+ * OutputBuffer. Every read and write is a large sequential block, and memory
+ * stays bounded by one run: the merge splits runSize values between the
+ * buffers of its runs.
+ *
+ * Duplicate values are rejected like in PmergeMe: inside a run before it is
+ * spilled, across runs during the last merge, after part of the output was
+ * written: the caller writes to a temporary file and discards it on failure.
+ */
+class ExternalSort
+{
+public:
+	static const std::size_t	DEFAULT_RUN_SIZE = 1 << 20;
+	static const std::size_t	MAX_FAN_IN = 128;
+	static const std::size_t	MIN_BLOCK_SIZE = 4096;
+
+	/*** constructor ***/
+	ExternalSort();
+	/*** parameterized constructor ***/
+	explicit ExternalSort(std::size_t runSize);
+	/*** destructor ***/
+	~ExternalSort();
+
+	/* Sorts input into output; returns the number of values, throws std::runtime_error on error */
+	std::size_t	sort(std::FILE* input, std::FILE* output);
+
+	std::size_t	getRuns() const;
+	std::size_t	getMergePasses() const;
+
+private:
+	/*** copy constructor ***/
+	ExternalSort(const ExternalSort& other);
+	/*** assignment operator ***/
+	ExternalSort& operator=(const ExternalSort& other);
+
+	std::size_t					_runSize;
+	std::size_t					_runs;
+	std::size_t					_mergePasses;
+	std::vector<std::FILE*>		_files;
+
+	void	sortRun(std::vector<int>& run) const;
+	void	spill(const std::vector<int>& run);
+	void	merge(const std::vector<std::FILE*>& runs, std::FILE* output, bool text);
+	void	closeFiles();
+};
+
+#endif
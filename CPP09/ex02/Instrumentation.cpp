@@ -0,0 +1,66 @@
+#include "Instrumentation.hpp"
+#include <cmath>
+#include <time.h>
+
+SortStats::SortStats() : comparisons(0), moves(0), pairingUs(0), recursionUs(0), insertionUs(0) {}
+
+void	SortStats::reset()
+{
+	*this = SortStats();
+}
+
+double	SortStats::totalUs() const
+{
+	return pairingUs + recursionUs + insertionUs;
+}
+
+/**
+ * @brief Reads CLOCK_MONOTONIC
+ *
+ * clock() measures CPU time of the whole process with a coarse resolution, so
+ * short sorts used to show up as 0 or as a multiple of the clock tick.
+ *
+ * @return double The current monotonic time in microseconds
+ */
+double	monotonicMicroseconds()
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<double>(ts.tv_sec) * 1000000.0 + static_cast<double>(ts.tv_nsec) / 1000.0;
+}
+
+/**
+ * @brief Minimum number of comparisons any comparison sort needs in the worst case
+ *
+ * log2(n!) is accumulated as a sum of logarithms; the small epsilon keeps exact
+ * powers of two (n = 1, 2) from being rounded up by floating point noise.
+ */
+unsigned long	comparisonLowerBound(std::size_t n)
+{
+	double	bits = 0.0;
+
+	for (std::size_t k = 2; k <= n; ++k)
+		bits += std::log(static_cast<double>(k)) / std::log(2.0);
+	return static_cast<unsigned long>(std::ceil(bits - 1e-9));
+}
+
+/**
+ * @brief Worst-case comparison count of the Ford-Johnson algorithm
+ *
+ * F(n) = sum_{k=1}^{n} ceil(log2(3k / 4)), computed with integers: ceil(log2(x))
+ * for x = 3k/4 is the smallest p such that 4 * 2^p >= 3k.
+ */
+unsigned long	fordJohnsonComparisons(std::size_t n)
+{
+	unsigned long	total = 0;
+
+	for (std::size_t k = 1; k <= n; ++k)
+	{
+		unsigned long	p = 0;
+		while ((4UL << p) < 3UL * k)
+			++p;
+		total += p;
+	}
+	return total;
+}
@@ -0,0 +1,37 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <cstddef>
+
+/**
+ * @brief Counters collected while sorting a sequence
+ *
+ * comparisons counts every call to the comparator. moves counts the positions
+ * written into the main chain (the inserted one plus every one shifted to make
+ * room for it) and the final placement of each element. Timings are the
+ * top-level pairing, recursive sort and insertion stages, in microseconds,
+ * taken with a monotonic clock.
+ */
+struct SortStats
+{
+	unsigned long	comparisons;
+	unsigned long	moves;
+	double			pairingUs;
+	double			recursionUs;
+	double			insertionUs;
+
+	SortStats();
+	void	reset();
+	double	totalUs() const;
+};
+
+/* Monotonic high-resolution time in microseconds (not affected by wall-clock changes) */
+double	monotonicMicroseconds();
+
+/* Information-theoretic lower bound: ceil(log2(n!)) comparisons */
+unsigned long	comparisonLowerBound(std::size_t n);
+
+/* Worst-case comparisons of Ford-Johnson: sum of ceil(log2(3k/4)) for k = 1..n */
+unsigned long	fordJohnsonComparisons(std::size_t n);
+
+#endif
@@ -0,0 +1,80 @@
+#include "IntegerReader.hpp"
+#include <climits>
+#include <sstream>
+#include <stdexcept>
+
+/*** parameterized constructor ***/
+IntegerReader::IntegerReader(std::FILE* file)
+	: _file(file), _buffer(BUFFER_SIZE), _position(0), _length(0), _count(0) {}
+
+/*** destructor ***/
+IntegerReader::~IntegerReader() {}
+
+std::size_t	IntegerReader::count() const
+{
+	return _count;
+}
+
+/* Reads the next block; false at end of input */
+bool	IntegerReader::refill()
+{
+	_position = 0;
+	_length = std::fread(&_buffer[0], 1, _buffer.size(), _file);
+	if (_length == 0 && std::ferror(_file))
+		throw std::runtime_error("Error: could not read input");
+	return _length > 0;
+}
+
+void	IntegerReader::fail(const char* reason) const
+{
+	std::ostringstream	message;
+
+	message << "Error: " << reason << " (value #" << _count + 1 << ")";
+	throw std::runtime_error(message.str());
+}
+
+/**
+ * @brief Parses the next value of the input
+ *
+ * Whitespace is skipped, then digits are accumulated until the next
+ * whitespace or the end of input. A value crossing a block boundary is
+ * simply continued after the refill.
+ *
+ * @param value Receives the parsed value
+ * @return true If a value was read, false at end of input
+ * @throws std::runtime_error On a non-digit character, zero, or a value above INT_MAX
+ */
+bool	IntegerReader::next(int& value)
+{
+	for (;;)
+	{
+		if (_position == _length && !refill())
+			return false;
+		char c = _buffer[_position];
+		if (c != ' ' && c != '\n' && c != '\t' && c != '\r' && c != '\v' && c != '\f')
+			break;
+		++_position;
+	}
+
+	long	number = 0;
+
+	for (;;)
+	{
+		if (_position == _length && !refill())
+			break;
+		char c = _buffer[_position];
+		if (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f')
+			break;
+		if (c < '0' || c > '9')
+			fail("Only positive integers are allowed!");
+		number = number * 10 + (c - '0');
+		if (number > INT_MAX)
+			fail("value exceed MAX INT value");
+		++_position;
+	}
+	if (number == 0)
+		fail("Only positive integers are allowed!");
+	value = static_cast<int>(number);
+	++_count;
+	return true;
+}
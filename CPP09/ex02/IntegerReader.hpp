@@ -0,0 +1,46 @@
+#ifndef INTEGERREADER_HPP
+#define INTEGERREADER_HPP
+
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+
+/**
+ * IntegerReader: reads whitespace-separated positive ints from a FILE*
+ *
+ * The file is read in 1 MiB blocks and parsed by hand, digit by digit, so a
+ * value is range checked (1 .. INT_MAX) while it is being read and no token
+ * string is ever built. Any other character, a sign or a zero value is an
+ * error.
+ */
+class IntegerReader
+{
+public:
+	static const std::size_t	BUFFER_SIZE = 1 << 20;
+
+	/*** parameterized constructor ***/
+	explicit IntegerReader(std::FILE* file);
+	/*** destructor ***/
+	~IntegerReader();
+
+	/* Reads the next value; returns false at end of input, throws std::runtime_error on bad input */
+	bool			next(int& value);
+	std::size_t		count() const;
+
+private:
+	/*** copy constructor ***/
+	IntegerReader(const IntegerReader& other);
+	/*** assignment operator ***/
+	IntegerReader& operator=(const IntegerReader& other);
+
+	std::FILE*			_file;
+	std::vector<char>	_buffer;
+	std::size_t			_position;
+	std::size_t			_length;
+	std::size_t			_count;
+
+	bool	refill();
+	void	fail(const char* reason) const;
+};
+
+#endif
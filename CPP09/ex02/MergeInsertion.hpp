@@ -0,0 +1,190 @@
+#ifndef MERGEINSERTION_HPP
+#define MERGEINSERTION_HPP
+
+#include <vector>
+#include <deque>
+#include <utility>
+#include <functional>
+#include <cstddef>
+#include "ChunkedVector.hpp"
+#include "Instrumentation.hpp"
+#include "Parallel.hpp"
+
+/**
+ * RebindContainer: the same container family holding another element type
+ *
+ * The engine keeps its bookkeeping (positions, pairs, the main chain) in the
+ * container it was instantiated with, so std::vector, std::deque and
+ * ChunkedVector are compared on the whole algorithm, not only on the input.
+ */
+template <typename Container, typename U>
+struct RebindContainer;
+
+template <typename T, typename Alloc, typename U>
+struct RebindContainer<std::vector<T, Alloc>, U> { typedef std::vector<U> type; };
+
+template <typename T, typename Alloc, typename U>
+struct RebindContainer<std::deque<T, Alloc>, U> { typedef std::deque<U> type; };
+
+template <typename T, typename U>
+struct RebindContainer<ChunkedVector<T>, U> { typedef ChunkedVector<U> type; };
+
+/**
+ * ConcurrentReads: whether several threads may call the const operator[] of
+ * the container at the same time. ChunkedVector caches the last chunk it
+ * looked up, so its parallel mode falls back to the sequential path.
+ */
+template <typename Container>
+struct ConcurrentReads { static const bool value = true; };
+
+template <typename T>
+struct ConcurrentReads<ChunkedVector<T> > { static const bool value = false; };
+
+/**
+ * SortItems: what the engine keeps of an element while sorting
+ *
+ * A trivially copyable element no larger than a position is copied into the
+ * engine's containers, so comparisons read it directly; any other element is
+ * referred to by its position in the sequence and only moved once, at the end.
+ */
+template <typename Container, bool Direct = __has_trivial_copy(typename Container::value_type)
+	&& __has_trivial_assign(typename Container::value_type)
+	&& sizeof(typename Container::value_type) <= sizeof(std::size_t)>
+struct SortItems
+{
+	typedef typename Container::value_type	value_type;
+	typedef std::size_t						item_type;
+
+	static item_type			make(const Container&, std::size_t position) { return position; }
+	static const value_type&	element(const Container& sequence, const item_type& item) { return sequence[item]; }
+};
+
+template <typename Container>
+struct SortItems<Container, true>
+{
+	typedef typename Container::value_type	value_type;
+	typedef value_type						item_type;
+
+	static item_type			make(const Container& sequence, std::size_t position) { return sequence[position]; }
+	static const value_type&	element(const Container&, const item_type& item) { return item; }
+};
+
+/**
+ * MergeInsertion: Ford-Johnson merge-insertion sort
+ *
+ * Container must offer random access (operator[]), push_back, insert, size,
+ * clear and swap; Compare is a strict weak ordering on its value_type. Every
+ * stage works on items (see SortItems): small elements such as ints or 64-bit
+ * keys are copied and compared directly, while records carrying a payload are
+ * sorted by position and moved once at the end.
+ *
+ * With setThreads(n > 0), levels of the recursion holding at least
+ * parallelThreshold elements compare their pairs on n threads and insert each
+ * Jacobsthal group with concurrent searches followed by one merge (see
+ * mergeGroup); smaller levels, and every level with setThreads(0), the
+ * default, use the sequential path. The recursion itself stays sequential:
+ * each level has a single sub-problem, the sorting of its keys.
+ *
+ * Levels of at most smallThreshold elements (16 by default, at most 16) are
+ * sorted by smallSort, the same algorithm on fixed-size arrays: no container
+ * is allocated below that size, and the comparison count is unchanged.
+ */
+template <typename Container, typename Compare = std::less<typename Container::value_type> >
+class MergeInsertion
+{
+public:
+	typedef typename Container::value_type	value_type;
+
+	static const std::size_t	DEFAULT_PARALLEL_THRESHOLD = 1 << 14;
+	static const std::size_t	SMALL_SORT_MAX = 16;
+
+	/*** constructor ***/
+	MergeInsertion();
+	/*** parameterized constructor ***/
+	explicit MergeInsertion(const Compare& compare);
+	/*** copy constructor ***/
+	MergeInsertion(const MergeInsertion& other);
+	/*** assignment operator ***/
+	MergeInsertion& operator=(const MergeInsertion& other);
+	/*** destructor ***/
+	~MergeInsertion();
+
+	void				sort(Container& sequence);
+	const SortStats&	getStats() const;
+
+	/* parallel mode */
+	void		setThreads(std::size_t threads);
+	void		setParallelThreshold(std::size_t threshold);
+	std::size_t	getThreads() const;
+
+	/* small-n kernel: levels of at most `threshold` elements (0 or 1 disables it, capped at SMALL_SORT_MAX) */
+	void		setSmallThreshold(std::size_t threshold);
+
+private:
+	typedef SortItems<Container>									Items;
+	typedef typename Items::item_type								item_type;
+	typedef typename RebindContainer<Container, item_type>::type	ItemContainer;
+	typedef typename RebindContainer<Container, std::size_t>::type	IndexContainer;
+	/* (key, value) positions of a pair: the key is the larger element */
+	typedef std::pair<std::size_t, std::size_t>						IndexPair;
+	typedef typename RebindContainer<Container, IndexPair>::type	PairContainer;
+	/* item of the sequential main chain and its index into the level's items */
+	typedef std::pair<item_type, std::size_t>						ChainEntry;
+
+	/*
+	 * Main chain being built by mergeKeysAndValues and what locates a(k) in it.
+	 * The sequential path inserts one element at a time into `chunks`, where an
+	 * insertion only shifts one chunk: in a flat container every insertion
+	 * shifts the tail and the insertion stage turns quadratic. Its entries
+	 * carry the item, so a search never goes back through items. The parallel
+	 * path rebuilds `order` once per group (see mergeGroup) and keeps it flat.
+	 */
+	struct Insertion
+	{
+		IndexContainer*				order;
+		ChunkedVector<ChainEntry>	chunks;
+		std::vector<std::size_t>	rank;
+		std::vector<std::size_t>	before;
+		std::size_t					keys;
+	};
+
+	class PairingTask;
+	class SearchTask;
+
+	Compare				_compare;
+	SortStats			_stats;
+	const Container*	_sequence;
+	std::size_t			_threads;
+	std::size_t			_parallelThreshold;
+	std::size_t			_smallThreshold;
+
+	bool	less(const item_type& a, const item_type& b);
+	bool	parallelLevel(std::size_t size) const;
+
+	void	pairAndSort(const ItemContainer& items, PairContainer& pairs, ItemContainer& keys);
+	void	recursiveSort(const ItemContainer& items, IndexContainer& order, std::size_t depth);
+	void	smallSort(const ItemContainer& items, std::size_t* order, std::size_t n);
+	void	extractKeysAndValues(const PairContainer& pairs, const IndexContainer& keyOrder,
+				IndexContainer& chain, IndexContainer& pend);
+	void	mergeKeysAndValues(const ItemContainer& items, const IndexContainer& chain,
+				const IndexContainer& pend, IndexContainer& order);
+
+	static const item_type&	chainItem(const ItemContainer& items, const IndexContainer& chain, std::size_t i);
+	static const item_type&	chainItem(const ItemContainer& items, const ChunkedVector<ChainEntry>& chain,
+								std::size_t i);
+	template <typename Chain>
+	static std::size_t	searchChain(const Container& sequence, const Compare& compare,
+							const ItemContainer& items, const Chain& chain,
+							std::size_t bound, std::size_t position, unsigned long& comparisons);
+	std::size_t	partnerBound(const Insertion& state, std::size_t k) const;
+	void		recordInsertion(Insertion& state, std::size_t position, std::size_t rank);
+	void		insertOne(const ItemContainer& items, Insertion& state, std::size_t position,
+					std::size_t bound);
+	void		mergeGroup(const ItemContainer& items, Insertion& state, const std::vector<std::size_t>& positions,
+					const std::vector<std::size_t>& bounds);
+};
+
+/* Include the implementation file */
+#include "MergeInsertion.tpp"
+
+#endif
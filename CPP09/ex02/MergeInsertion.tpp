@@ -0,0 +1,651 @@
+#ifndef MERGEINSERTION_TPP
+#define MERGEINSERTION_TPP
+
+#include "MergeInsertion.hpp"
+#include <algorithm>
+
+/* --- Canonical Form --- */
+
+/* Constructor */
+template <typename Container, typename Compare>
+MergeInsertion<Container, Compare>::MergeInsertion()
+	: _compare(), _stats(), _sequence(NULL), _threads(0), _parallelThreshold(DEFAULT_PARALLEL_THRESHOLD),
+	_smallThreshold(SMALL_SORT_MAX) {}
+
+/* Parameterized Constructor */
+template <typename Container, typename Compare>
+MergeInsertion<Container, Compare>::MergeInsertion(const Compare& compare)
+	: _compare(compare), _stats(), _sequence(NULL), _threads(0), _parallelThreshold(DEFAULT_PARALLEL_THRESHOLD),
+	_smallThreshold(SMALL_SORT_MAX) {}
+
+/* Copy Constructor */
+template <typename Container, typename Compare>
+MergeInsertion<Container, Compare>::MergeInsertion(const MergeInsertion& other)
+	: _compare(other._compare), _stats(other._stats), _sequence(NULL), _threads(other._threads),
+	_parallelThreshold(other._parallelThreshold), _smallThreshold(other._smallThreshold) {}
+
+/* Assignment Operator */
+template <typename Container, typename Compare>
+MergeInsertion<Container, Compare>& MergeInsertion<Container, Compare>::operator=(const MergeInsertion& other)
+{
+	if (this != &other)
+	{
+		_compare = other._compare;
+		_stats = other._stats;
+		_threads = other._threads;
+		_parallelThreshold = other._parallelThreshold;
+		_smallThreshold = other._smallThreshold;
+	}
+	return *this;
+}
+
+/* Destructor */
+template <typename Container, typename Compare>
+MergeInsertion<Container, Compare>::~MergeInsertion() {}
+
+/**
+ * @brief Sorts a sequence with the Ford-Johnson algorithm
+ *
+ * The recursion produces the sorted order as indexes into the items; the
+ * elements are then copied once into a new container which is swapped in.
+ * Timings of the top-level pairing, recursive sort and insertion are kept in
+ * the stats together with the comparison and move counters.
+ *
+ * @param sequence The container to sort in place
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::sort(Container& sequence)
+{
+	_stats.reset();
+	if (sequence.size() < 2)
+		return;
+
+	_sequence = &sequence;
+
+	ItemContainer	items;
+	IndexContainer	order;
+
+	for (std::size_t i = 0; i < sequence.size(); ++i)
+		items.push_back(Items::make(sequence, i));
+	recursiveSort(items, order, 0);
+
+	Container	sorted;
+
+	for (std::size_t i = 0; i < order.size(); ++i)
+		sorted.push_back(Items::element(sequence, items[order[i]]));
+	_stats.moves += order.size();
+	sequence.swap(sorted);
+	_sequence = NULL;
+}
+
+template <typename Container, typename Compare>
+const SortStats&	MergeInsertion<Container, Compare>::getStats() const
+{
+	return _stats;
+}
+
+/* --- Parallel mode --- */
+
+/* Threads of the parallel path; 0 selects the sequential path (exact Ford-Johnson) */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::setThreads(std::size_t threads)
+{
+	_threads = threads;
+}
+
+/* Smallest level size sorted with the parallel path */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::setParallelThreshold(std::size_t threshold)
+{
+	_parallelThreshold = threshold;
+}
+
+template <typename Container, typename Compare>
+std::size_t	MergeInsertion<Container, Compare>::getThreads() const
+{
+	return _threads;
+}
+
+/* --- Small-n kernel --- */
+
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::setSmallThreshold(std::size_t threshold)
+{
+	_smallThreshold = (threshold < SMALL_SORT_MAX) ? threshold : SMALL_SORT_MAX;
+}
+
+template <typename Container, typename Compare>
+bool	MergeInsertion<Container, Compare>::parallelLevel(std::size_t size) const
+{
+	return _threads > 0 && size >= _parallelThreshold
+		&& ConcurrentReads<Container>::value && ConcurrentReads<IndexContainer>::value;
+}
+
+/* Compares the two elements of every pair in [begin, end) of the pair range */
+template <typename Container, typename Compare>
+class MergeInsertion<Container, Compare>::PairingTask : public ParallelTask
+{
+public:
+	std::vector<char>			swapped;
+	std::vector<unsigned long>	comparisons;
+
+	PairingTask(const Container& sequence, const Compare& compare, const ItemContainer& items,
+		std::size_t workers)
+		: swapped(items.size() / 2, 0), comparisons(workers, 0),
+		_sequence(sequence), _compare(compare), _items(items) {}
+
+	void	run(std::size_t begin, std::size_t end, std::size_t worker)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+			swapped[i] = _compare(Items::element(_sequence, _items[2 * i + 1]),
+				Items::element(_sequence, _items[2 * i]));
+		comparisons[worker] += end - begin;
+	}
+
+private:
+	const Container&		_sequence;
+	const Compare&			_compare;
+	const ItemContainer&	_items;
+};
+
+/* Searches the gap of every pend element of a group in the chain as it was before the group */
+template <typename Container, typename Compare>
+class MergeInsertion<Container, Compare>::SearchTask : public ParallelTask
+{
+public:
+	std::vector<std::size_t>	gaps;
+	std::vector<unsigned long>	comparisons;
+
+	SearchTask(const Container& sequence, const Compare& compare, const ItemContainer& items,
+		const IndexContainer& order, const std::vector<std::size_t>& positions,
+		const std::vector<std::size_t>& bounds, std::size_t workers)
+		: gaps(positions.size(), 0), comparisons(workers, 0), _sequence(sequence), _compare(compare),
+		_items(items), _order(order), _positions(positions), _bounds(bounds) {}
+
+	void	run(std::size_t begin, std::size_t end, std::size_t worker)
+	{
+		unsigned long	count = 0;
+
+		for (std::size_t i = begin; i < end; ++i)
+			gaps[i] = searchChain(_sequence, _compare, _items, _order, _bounds[i], _positions[i], count);
+		comparisons[worker] += count;
+	}
+
+private:
+	const Container&					_sequence;
+	const Compare&						_compare;
+	const ItemContainer&				_items;
+	const IndexContainer&				_order;
+	const std::vector<std::size_t>&		_positions;
+	const std::vector<std::size_t>&		_bounds;
+};
+
+/* Compares the elements of two items, counting the comparison */
+template <typename Container, typename Compare>
+bool	MergeInsertion<Container, Compare>::less(const item_type& a, const item_type& b)
+{
+	++_stats.comparisons;
+	return _compare(Items::element(*_sequence, a), Items::element(*_sequence, b));
+}
+
+/**
+ * @brief Sorts the elements of a level
+ *
+ * @param items The elements to sort (see SortItems)
+ * @param order Receives the sorted order as indexes into items
+ * @param depth Recursion depth, stage timings are only taken at depth 0
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::recursiveSort(const ItemContainer& items,
+	IndexContainer& order, std::size_t depth)
+{
+	order.clear();
+	if (items.size() == 0)
+		return;
+	if (items.size() == 1)
+	{
+		order.push_back(0);
+		return;
+	}
+	if (items.size() <= _smallThreshold)
+	{
+		std::size_t	local[SMALL_SORT_MAX];
+
+		for (std::size_t i = 0; i < items.size(); ++i)
+			local[i] = i;
+		smallSort(items, local, items.size());
+		for (std::size_t i = 0; i < items.size(); ++i)
+			order.push_back(local[i]);
+		return;
+	}
+
+	PairContainer	pairs;
+	ItemContainer	keys;
+	IndexContainer	keyOrder;
+	IndexContainer	chain;
+	IndexContainer	pend;
+	double			start = (depth == 0) ? monotonicMicroseconds() : 0;
+
+	pairAndSort(items, pairs, keys);
+	if (depth == 0)
+	{
+		_stats.pairingUs = monotonicMicroseconds() - start;
+		start = monotonicMicroseconds();
+	}
+
+	recursiveSort(keys, keyOrder, depth + 1);
+	if (depth == 0)
+	{
+		_stats.recursionUs = monotonicMicroseconds() - start;
+		start = monotonicMicroseconds();
+	}
+
+	extractKeysAndValues(pairs, keyOrder, chain, pend);
+	mergeKeysAndValues(items, chain, pend, order);
+	if (depth == 0)
+		_stats.insertionUs = monotonicMicroseconds() - start;
+}
+
+/**
+ * @brief Ford-Johnson on at most SMALL_SORT_MAX elements, in arrays on the stack
+ *
+ * Same pairing, recursion and Jacobsthal insertion as the container path,
+ * with the same bounded searches, so it performs the same comparisons: only
+ * the bookkeeping changes. Indexes into items are permuted in place; a key
+ * finds its value through `partner` and its place in the chain with a scan,
+ * both free of comparisons.
+ *
+ * @param items The elements being sorted
+ * @param order Indexes into items to sort, sorted in place
+ * @param n Number of indexes in order (at most SMALL_SORT_MAX)
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::smallSort(const ItemContainer& items, std::size_t* order,
+	std::size_t n)
+{
+	if (n < 2)
+		return;
+
+	const std::size_t	half = n / 2;
+	const std::size_t	total = n - half;
+	const std::size_t	odd = order[n - 1];
+	std::size_t			keys[SMALL_SORT_MAX / 2];
+	std::size_t			partner[SMALL_SORT_MAX];
+
+	for (std::size_t i = 0; i < half; ++i)
+	{
+		std::size_t	a = order[2 * i];
+		std::size_t	b = order[2 * i + 1];
+
+		if (less(items[b], items[a]))
+			std::swap(a, b);
+		keys[i] = b;
+		partner[b] = a;
+	}
+	smallSort(items, keys, half);
+
+	std::size_t	length = 0;
+
+	order[length++] = partner[keys[0]];
+	for (std::size_t k = 0; k < half; ++k)
+		order[length++] = keys[k];
+
+	std::size_t	inserted = 1;
+	std::size_t	previous = 1;
+	std::size_t	current = 3;
+
+	while (inserted < total)
+	{
+		std::size_t	last = (current < total) ? current : total;
+
+		for (std::size_t j = last; j > inserted; --j)
+		{
+			std::size_t	k = j - 1;
+			std::size_t	element = (k < half) ? partner[keys[k]] : odd;
+			std::size_t	bound = length;
+
+			if (k < half)
+			{
+				bound = 0;
+				while (order[bound] != keys[k])
+					++bound;
+			}
+
+			std::size_t	low = 0;
+
+			while (bound > 0)
+			{
+				std::size_t	step = bound / 2;
+
+				if (less(items[order[low + step]], items[element]))
+				{
+					low += step + 1;
+					bound -= step + 1;
+				}
+				else
+					bound = step;
+			}
+			for (std::size_t i = length; i > low; --i)
+				order[i] = order[i - 1];
+			order[low] = element;
+			_stats.moves += 1 + (length - low);
+			++length;
+		}
+		inserted = last;
+
+		std::size_t	next = current + 2 * previous;
+		previous = current;
+		current = next;
+	}
+}
+
+/**
+ * @brief Pairs adjacent elements and orders each pair with one comparison
+ *
+ * The larger element of a pair is its key, the smaller its value. An odd
+ * element is left out and inserted last by mergeKeysAndValues. On a parallel
+ * level the comparisons are split between the threads first.
+ *
+ * @param items The elements to pair
+ * @param pairs Receives (key, value) as indexes into items
+ * @param keys Receives the item of every key, to be sorted recursively
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::pairAndSort(const ItemContainer& items,
+	PairContainer& pairs, ItemContainer& keys)
+{
+	if (parallelLevel(items.size()))
+	{
+		PairingTask	task(*_sequence, _compare, items, _threads);
+
+		parallelFor(task.swapped.size(), _threads, task);
+		for (std::size_t w = 0; w < task.comparisons.size(); ++w)
+			_stats.comparisons += task.comparisons[w];
+		for (std::size_t i = 0; i < task.swapped.size(); ++i)
+		{
+			if (task.swapped[i])
+				pairs.push_back(IndexPair(2 * i, 2 * i + 1));
+			else
+				pairs.push_back(IndexPair(2 * i + 1, 2 * i));
+			keys.push_back(items[pairs.back().first]);
+		}
+		return;
+	}
+	for (std::size_t i = 0; i + 1 < items.size(); i += 2)
+	{
+		if (less(items[i + 1], items[i]))
+			pairs.push_back(IndexPair(i, i + 1));
+		else
+			pairs.push_back(IndexPair(i + 1, i));
+		keys.push_back(items[pairs.back().first]);
+	}
+}
+
+/**
+ * @brief Splits the pairs, in sorted key order, into main chain and pend
+ *
+ * @param pairs The (key, value) pairs as indexes into items
+ * @param keyOrder Sorted order of the keys, as indexes into pairs
+ * @param chain Receives the keys in sorted order
+ * @param pend Receives the value paired with each key of the chain
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::extractKeysAndValues(const PairContainer& pairs,
+	const IndexContainer& keyOrder, IndexContainer& chain, IndexContainer& pend)
+{
+	for (std::size_t k = 0; k < keyOrder.size(); ++k)
+	{
+		chain.push_back(pairs[keyOrder[k]].first);
+		pend.push_back(pairs[keyOrder[k]].second);
+	}
+}
+
+/* Item at index i of a chain: the parallel chain holds indexes into items */
+template <typename Container, typename Compare>
+const typename MergeInsertion<Container, Compare>::item_type&
+	MergeInsertion<Container, Compare>::chainItem(const ItemContainer& items, const IndexContainer& chain,
+	std::size_t i)
+{
+	return items[chain[i]];
+}
+
+/* Item at index i of a chain: the sequential chain holds the items themselves */
+template <typename Container, typename Compare>
+const typename MergeInsertion<Container, Compare>::item_type&
+	MergeInsertion<Container, Compare>::chainItem(const ItemContainer&, const ChunkedVector<ChainEntry>& chain,
+	std::size_t i)
+{
+	return chain[i].first;
+}
+
+/**
+ * @brief Lower bound of items[position] within chain[0, bound)
+ *
+ * A plain halving search: a range of 2^t - 1 elements costs at most t
+ * comparisons, which is what the Jacobsthal insertion order relies on. Static
+ * so that the search threads can run it without touching the engine.
+ */
+template <typename Container, typename Compare>
+template <typename Chain>
+std::size_t	MergeInsertion<Container, Compare>::searchChain(const Container& sequence, const Compare& compare,
+	const ItemContainer& items, const Chain& chain, std::size_t bound, std::size_t position,
+	unsigned long& comparisons)
+{
+	const value_type&	target = Items::element(sequence, items[position]);
+	std::size_t			low = 0;
+	std::size_t			length = bound;
+
+	while (length > 0)
+	{
+		std::size_t	half = length / 2;
+
+		++comparisons;
+		if (compare(Items::element(sequence, chainItem(items, chain, low + half)), target))
+		{
+			low += half + 1;
+			length -= half + 1;
+		}
+		else
+			length = half;
+	}
+	return low;
+}
+
+/**
+ * @brief Inserts the pend elements into the main chain in Jacobsthal order
+ *
+ * The chain starts as b1 a1 a2 ... am (b1 < a1 is already known). Pend
+ * elements are then inserted by groups b(t_k), b(t_k - 1), ..., b(t_{k-1} + 1)
+ * with t = 3, 5, 11, 21, 43, ... so that every b(j) is searched among at most
+ * 2^k - 1 elements: only the ones before its own a(j).
+ *
+ * @param items The elements being sorted
+ * @param chain Sorted keys, as indexes into items
+ * @param pend Value paired with each key, as indexes into items
+ * @param order Receives the sorted order as indexes into items
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::mergeKeysAndValues(const ItemContainer& items,
+	const IndexContainer& chain, const IndexContainer& pend, IndexContainer& order)
+{
+	const std::size_t	m = chain.size();
+	const bool			odd = (items.size() % 2 != 0);
+	const std::size_t	total = m + (odd ? 1 : 0);
+	const bool			parallel = parallelLevel(items.size());
+	Insertion			state;
+
+	state.order = &order;
+	state.rank.assign(items.size(), 0);
+	state.before.assign(m + 2, 0);
+	state.keys = m;
+
+	if (parallel)
+		order.push_back(pend[0]);
+	else
+		state.chunks.push_back(ChainEntry(items[pend[0]], pend[0]));
+	for (std::size_t k = 0; k < m; ++k)
+	{
+		if (parallel)
+			order.push_back(chain[k]);
+		else
+			state.chunks.push_back(ChainEntry(items[chain[k]], chain[k]));
+		state.rank[chain[k]] = k;
+	}
+
+	std::size_t	inserted = 1;
+	std::size_t	previous = 1;
+	std::size_t	current = 3;
+
+	while (inserted < total)
+	{
+		std::size_t					last = (current < total) ? current : total;
+		std::vector<std::size_t>	positions;
+		std::vector<std::size_t>	bounds;
+
+		for (std::size_t j = last; j > inserted; --j)
+		{
+			std::size_t	k = j - 1;
+			std::size_t	position = (k < m) ? pend[k] : items.size() - 1;
+
+			if (!parallel)
+				insertOne(items, state, position, (k < m) ? partnerBound(state, k) : state.chunks.size());
+			else
+			{
+				positions.push_back(position);
+				bounds.push_back((k < m) ? partnerBound(state, k) : order.size());
+			}
+		}
+		if (parallel)
+			mergeGroup(items, state, positions, bounds);
+		inserted = last;
+
+		std::size_t	next = current + 2 * previous;
+		previous = current;
+		current = next;
+	}
+	if (!parallel)
+		for (std::size_t i = 0; i < state.chunks.size(); ++i)
+			order.push_back(state.chunks[i].second);
+}
+
+/**
+ * @brief Position of a(k) in the chain, found without comparisons
+ *
+ * Every inserted element remembers the index r of the first a after it, and
+ * the Fenwick tree `before` counts inserted elements per r: a(k) sits after
+ * b1, a(0..k-1) and every inserted element with r <= k.
+ */
+template <typename Container, typename Compare>
+std::size_t	MergeInsertion<Container, Compare>::partnerBound(const Insertion& state, std::size_t k) const
+{
+	std::size_t	bound = 1 + k;
+
+	for (std::size_t i = k + 1; i > 0; i -= i & (~i + 1))
+		bound += state.before[i];
+	return bound;
+}
+
+/* Stores r (index of the first a after the element) and counts it in the Fenwick tree */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::recordInsertion(Insertion& state, std::size_t position,
+	std::size_t rank)
+{
+	state.rank[position] = rank;
+	for (std::size_t i = rank + 1; i < state.before.size(); i += i & (~i + 1))
+		++state.before[i];
+}
+
+/*
+ * Sequential path: binary search in chunks[0, bound) then insert in place.
+ * moves still counts the tail a flat chain would shift, so the figure stays
+ * comparable across containers and with the parallel path.
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::insertOne(const ItemContainer& items, Insertion& state,
+	std::size_t position, std::size_t bound)
+{
+	ChunkedVector<ChainEntry>&	chain = state.chunks;
+	std::size_t					at = searchChain(*_sequence, _compare, items, chain, bound, position,
+									_stats.comparisons);
+
+	_stats.moves += 1 + (chain.size() - at);
+	chain.insert(chain.begin() + at, ChainEntry(items[position], position));
+	recordInsertion(state, position, (at + 1 < chain.size()) ? state.rank[chain[at + 1].second] : state.keys);
+}
+
+/**
+ * @brief Parallel path: inserts a whole Jacobsthal group with one merge
+ *
+ * The searches of a group only read the chain as it was before the group, so
+ * they run concurrently; each range is still bounded by the element's own
+ * a(k), hence at most k comparisons per search. Elements landing in the same
+ * gap are then ordered among themselves (the only comparisons not covered by
+ * the Ford-Johnson bound) and the chain is rebuilt in one pass, which also
+ * replaces one O(n) shift per element by one O(n) merge per group.
+ *
+ * @param items The elements being sorted
+ * @param state The chain and the structures locating a(k) in it
+ * @param positions Elements of the group, as indexes into items
+ * @param bounds Search bound of each element in the current chain
+ */
+template <typename Container, typename Compare>
+void	MergeInsertion<Container, Compare>::mergeGroup(const ItemContainer& items, Insertion& state,
+	const std::vector<std::size_t>& positions, const std::vector<std::size_t>& bounds)
+{
+	IndexContainer&	order = *state.order;
+	SearchTask		task(*_sequence, _compare, items, order, positions, bounds, _threads);
+
+	parallelFor(positions.size(), _threads, task);
+	for (std::size_t w = 0; w < task.comparisons.size(); ++w)
+		_stats.comparisons += task.comparisons[w];
+
+	/* (gap, element) sorted by gap: no element comparison involved */
+	std::vector<IndexPair>	placed;
+	for (std::size_t i = 0; i < positions.size(); ++i)
+		placed.push_back(IndexPair(task.gaps[i], positions[i]));
+	std::sort(placed.begin(), placed.end());
+
+	/* binary insertion among the elements sharing a gap */
+	for (std::size_t runStart = 0, i = 1; i < placed.size(); ++i)
+	{
+		if (placed[i].first != placed[runStart].first)
+		{
+			runStart = i;
+			continue;
+		}
+		IndexPair	current = placed[i];
+		std::size_t	low = runStart;
+		std::size_t	high = i;
+		while (low < high)
+		{
+			std::size_t	middle = low + (high - low) / 2;
+			if (less(items[placed[middle].second], items[current.second]))
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		for (std::size_t j = i; j > low; --j)
+			placed[j] = placed[j - 1];
+		placed[low] = current;
+	}
+
+	IndexContainer	merged;
+	std::size_t		next = 0;
+
+	for (std::size_t gap = 0; gap <= order.size(); ++gap)
+	{
+		std::size_t	rank = (gap < order.size()) ? state.rank[order[gap]] : state.keys;
+
+		for (; next < placed.size() && placed[next].first == gap; ++next)
+		{
+			merged.push_back(placed[next].second);
+			recordInsertion(state, placed[next].second, rank);
+		}
+		if (gap < order.size())
+			merged.push_back(order[gap]);
+	}
+	_stats.moves += merged.size();
+	order.swap(merged);
+}
+
+#endif
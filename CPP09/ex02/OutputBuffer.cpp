@@ -0,0 +1,60 @@
+#include "OutputBuffer.hpp"
+
+/*** parameterized constructor ***/
+OutputBuffer::OutputBuffer(std::FILE* file) : _file(file), _buffer(BUFFER_SIZE), _length(0) {}
+
+/*** destructor ***/
+OutputBuffer::~OutputBuffer()
+{
+	flush();
+}
+
+void	OutputBuffer::flush()
+{
+	if (_length > 0)
+		std::fwrite(&_buffer[0], 1, _length, _file);
+	_length = 0;
+	std::fflush(_file);
+}
+
+void	OutputBuffer::write(char c)
+{
+	if (_length == _buffer.size())
+		flush();
+	_buffer[_length++] = c;
+}
+
+void	OutputBuffer::write(const char* text)
+{
+	while (*text)
+		write(*text++);
+}
+
+/* Digits are produced backwards into a small array, then copied in order */
+void	OutputBuffer::write(unsigned long long value)
+{
+	char		digits[20];
+	std::size_t	count = 0;
+
+	do
+	{
+		digits[count++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	if (_length + count > _buffer.size())
+		flush();
+	while (count > 0)
+		_buffer[_length++] = digits[--count];
+}
+
+void	OutputBuffer::write(int value)
+{
+	if (value < 0)
+	{
+		write('-');
+		write(static_cast<unsigned long long>(-static_cast<long long>(value)));
+	}
+	else
+		write(static_cast<unsigned long long>(value));
+}
@@ -0,0 +1,44 @@
+#ifndef OUTPUTBUFFER_HPP
+#define OUTPUTBUFFER_HPP
+
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+
+/**
+ * OutputBuffer: formats integers by hand into a 1 MiB block written with one
+ * fwrite when full (or on flush)
+ *
+ * Printing a sequence through std::cout costs a formatted insertion per value;
+ * here a value is a handful of stores into the block. The destructor flushes.
+ * Output already sent to std::cout stays in order as long as the standard
+ * streams are synchronized with stdio (the default).
+ */
+class OutputBuffer
+{
+public:
+	static const std::size_t	BUFFER_SIZE = 1 << 20;
+
+	/*** parameterized constructor ***/
+	explicit OutputBuffer(std::FILE* file);
+	/*** destructor ***/
+	~OutputBuffer();
+
+	void	write(const char* text);
+	void	write(char c);
+	void	write(unsigned long long value);
+	void	write(int value);
+	void	flush();
+
+private:
+	/*** copy constructor ***/
+	OutputBuffer(const OutputBuffer& other);
+	/*** assignment operator ***/
+	OutputBuffer& operator=(const OutputBuffer& other);
+
+	std::FILE*			_file;
+	std::vector<char>	_buffer;
+	std::size_t			_length;
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "Parallel.hpp"
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+
+std::size_t	hardwareThreads()
+{
+	long	online = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (online > 0) ? static_cast<std::size_t>(online) : 1;
+}
+
+/* Constructor */
+WorkerPool::WorkerPool(std::size_t threads)
+	: _task(NULL), _count(0), _slices(0), _next(0), _failed(false), _busy(0), _generation(0), _stop(false)
+{
+	pthread_mutex_init(&_mutex, NULL);
+	pthread_cond_init(&_wake, NULL);
+	pthread_cond_init(&_done, NULL);
+	for (std::size_t i = 1; i < threads; ++i)
+	{
+		pthread_t	worker;
+
+		if (pthread_create(&worker, NULL, workerMain, this) == 0)
+			_workers.push_back(worker);
+	}
+}
+
+/* Destructor */
+WorkerPool::~WorkerPool()
+{
+	pthread_mutex_lock(&_mutex);
+	_stop = true;
+	pthread_cond_broadcast(&_wake);
+	pthread_mutex_unlock(&_mutex);
+	for (std::size_t i = 0; i < _workers.size(); ++i)
+		pthread_join(_workers[i], NULL);
+	pthread_cond_destroy(&_done);
+	pthread_cond_destroy(&_wake);
+	pthread_mutex_destroy(&_mutex);
+}
+
+std::size_t	WorkerPool::size() const
+{
+	return _workers.size() + 1;
+}
+
+void	WorkerPool::run(ParallelTask& task, std::size_t count, std::size_t slices)
+{
+	pthread_mutex_lock(&_mutex);
+	_task = &task;
+	_count = count;
+	_slices = slices;
+	_next = 0;
+	_failed = false;
+	_busy = _workers.size();
+	_generation++;
+	pthread_cond_broadcast(&_wake);
+	pthread_mutex_unlock(&_mutex);
+
+	work();
+
+	pthread_mutex_lock(&_mutex);
+	while (_busy > 0)
+		pthread_cond_wait(&_done, &_mutex);
+	_task = NULL;
+	pthread_mutex_unlock(&_mutex);
+
+	if (_failed)
+		throw std::runtime_error("parallelFor: a slice threw an exception");
+}
+
+void*	WorkerPool::workerMain(void* pool)
+{
+	static_cast<WorkerPool*>(pool)->wait();
+	return NULL;
+}
+
+/* Worker loop: sleep until a new generation (or stop), claim slices, report done */
+void	WorkerPool::wait()
+{
+	unsigned long	seen = 0;
+
+	pthread_mutex_lock(&_mutex);
+	while (true)
+	{
+		while (!_stop && _generation == seen)
+			pthread_cond_wait(&_wake, &_mutex);
+		if (_stop)
+			break;
+		seen = _generation;
+		pthread_mutex_unlock(&_mutex);
+
+		work();
+
+		pthread_mutex_lock(&_mutex);
+		if (--_busy == 0)
+			pthread_cond_signal(&_done);
+	}
+	pthread_mutex_unlock(&_mutex);
+}
+
+void	WorkerPool::work()
+{
+	std::size_t	slice;
+
+	while ((slice = __sync_fetch_and_add(&_next, 1)) < _slices)
+	{
+		try
+		{
+			_task->run(_count * slice / _slices, _count * (slice + 1) / _slices, slice);
+		}
+		catch (...)
+		{
+			_failed = true;
+		}
+	}
+}
+
+/* Shared by every parallelFor, joined at exit */
+static WorkerPool&	sharedPool(std::size_t threads)
+{
+	static std::auto_ptr<WorkerPool>	pool;
+
+	if (pool.get() == NULL || pool->size() < threads)
+	{
+		pool.reset();
+		pool.reset(new WorkerPool(threads));
+	}
+	return *pool;
+}
+
+void	parallelFor(std::size_t count, std::size_t threads, ParallelTask& task)
+{
+	if (threads > count)
+		threads = count;
+	if (threads <= 1)
+	{
+		if (count > 0)
+			task.run(0, count, 0);
+		return;
+	}
+	sharedPool(threads).run(task, count, threads);
+}
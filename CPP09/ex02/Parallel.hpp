@@ -0,0 +1,76 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <pthread.h>
+
+/**
+ * Work split by parallelFor: run() receives a contiguous slice [begin, end)
+ * of the index range and the number of the worker processing it.
+ */
+class ParallelTask
+{
+public:
+	virtual ~ParallelTask() {}
+	virtual void	run(std::size_t begin, std::size_t end, std::size_t worker) = 0;
+};
+
+/* Number of online processors (1 if it cannot be determined) */
+std::size_t	hardwareThreads();
+
+/**
+ * Fixed set of POSIX threads kept alive between calls, so a parallel step
+ * pays a wake-up instead of a thread creation. run() lets the workers and
+ * the calling thread claim slices from a shared atomic counter and returns
+ * once every slice is done. If a slice throws, the other slices still run
+ * and run() throws std::runtime_error on the calling thread. Workers that
+ * cannot be created are dropped, down to the caller alone. One run() at a
+ * time per pool.
+ */
+class WorkerPool
+{
+public:
+	/* Constructor: threads counts the caller */
+	explicit WorkerPool(std::size_t threads);
+	/* Destructor */
+	~WorkerPool();
+
+	std::size_t	size() const;
+
+	/* Runs [0, count) split into `slices` contiguous slices, slice i as worker i */
+	void		run(ParallelTask& task, std::size_t count, std::size_t slices);
+
+private:
+	/* Copy Constructor / Assignment Operator: a pool owns its threads */
+	WorkerPool(const WorkerPool& other);
+	WorkerPool&	operator=(const WorkerPool& other);
+
+	static void*	workerMain(void* pool);
+	void			wait();
+	void			work();
+
+	std::vector<pthread_t>	_workers;
+	pthread_mutex_t			_mutex;
+	pthread_cond_t			_wake;
+	pthread_cond_t			_done;
+	ParallelTask*			_task;
+	std::size_t				_count;
+	std::size_t				_slices;
+	volatile std::size_t	_next;
+	volatile bool			_failed;
+	std::size_t				_busy;
+	unsigned long			_generation;
+	bool					_stop;
+};
+
+/**
+ * Splits [0, count) into `threads` contiguous slices and runs them on a
+ * process-wide WorkerPool, the calling thread taking part. The pool is
+ * created on first use and replaced by a larger one when a call asks for
+ * more threads. Returns once every slice is done; throws std::runtime_error
+ * if a slice threw. Not reentrant: one parallelFor at a time.
+ */
+void	parallelFor(std::size_t count, std::size_t threads, ParallelTask& task);
+
+#endif
@@ -1,20 +1,19 @@
 #include "PmergeMe.hpp"
+#include "IntegerReader.hpp"
+#include "OutputBuffer.hpp"
 #include <iostream>
-#include <utility>
-#include <algorithm>
-#include <climits>
 #include <stdexcept>
-#include <set>
 #include <iomanip>
-#include <ctime>
+#include <cstdio>
 
 /* --- Canonical Form --- */
 
 /* Constructor */
-PmergeMe::PmergeMe() : _deque(0), _vector(0), _oddSequence(false) {}
+PmergeMe::PmergeMe() : _deque(0), _vector(0), _stats(), _threads(0), _display(DISPLAY_ALL), _prefix(0) {}
 
 /* Copy Constructor */
-PmergeMe::PmergeMe(const PmergeMe& other) : _deque(other._deque), _vector(other._vector), _oddSequence(other._oddSequence) {}
+PmergeMe::PmergeMe(const PmergeMe& other) : _deque(other._deque), _vector(other._vector), _stats(other._stats), _threads(other._threads),
+	_display(other._display), _prefix(other._prefix) {}
 
 /* Assignment Operator */
 PmergeMe& PmergeMe::operator=(const PmergeMe& other)
@@ -23,7 +22,10 @@ PmergeMe& PmergeMe::operator=(const PmergeMe& other)
 	{
 		_deque = other._deque;
 		_vector = other._vector;
-		_oddSequence = other._oddSequence;
+		_stats = other._stats;
+		_threads = other._threads;
+		_display = other._display;
+		_prefix = other._prefix;
 	}
 	return *this;
 }
@@ -32,300 +34,325 @@ PmergeMe& PmergeMe::operator=(const PmergeMe& other)
 PmergeMe::~PmergeMe() {}
 
 /**
- * @brief Adds a sequence of positive integers to the deque and vector containers
- * 
- * We use a std::set to check for any duplicate number while adding the sequence into the
- * container
+ * @brief Looks for a repeated value with one bit per value of [min, max]
  * 
- * @param sequence A sequence of positive integers
- * @throws std::runtime_error If any integer in the sequence is negative
+ * @return true If a value appears twice
  */
-void PmergeMe::addSequence(const std::vector<int>& sequence)
+static bool	hasDuplicateInBitmap(const int* first, const int* last, int min, unsigned long range)
 {
-	std::set<int> seenValues;
+	std::vector<unsigned char>	seen((range + 7) / 8, 0);
 
-	if (sequence.size() == 1)
-		throw std::runtime_error("Error: cannot sort a single number");
-
-	for (std::vector<int>::const_iterator it = sequence.begin(); it != sequence.end(); ++it)
+	for (const int* it = first; it != last; ++it)
 	{
-		if (*it < 0)
-			throw std::runtime_error("Error: Only positive integers are allowed");
-
-		if (seenValues.find(*it) != seenValues.end()) {
-			throw std::runtime_error("Error: Duplicate values are not allowed");
-		}
+		unsigned long	bit = static_cast<unsigned long>(*it - min);
+		unsigned char	mask = static_cast<unsigned char>(1u << (bit & 7));
 
-		if (*it > INT_MAX)
-			throw std::runtime_error("Error: Input number cannot be greater than INT_MAX value");
-
-		_deque.push_back(*it);
-		_vector.push_back(*it);
-		seenValues.insert(*it);
+		if (seen[bit >> 3] & mask)
+			return true;
+		seen[bit >> 3] |= mask;
 	}
+	return false;
 }
 
 /**
- * @brief Sorts the sequence stored in the deque using the merge-insert algorithm
+ * @brief Looks for a repeated value with an open-addressing hash set
+ * 
+ * The table is a flat array of at least twice as many slots as values (-1
+ * marks an empty slot, all values are positive), probed linearly from a
+ * multiplicative hash: no node allocation, one or two cache lines per value.
+ * 
+ * @return true If a value appears twice
  */
-void	PmergeMe::sortSequenceWithDeque()
+static bool	hasDuplicateInHashSet(const int* first, const int* last)
 {
-	std::deque<std::pair<int, int> >	pairs;
-
-	pairAndSort(pairs, _deque);
+	std::size_t		count = static_cast<std::size_t>(last - first);
+	unsigned int	bits = 1;
 
-	std::deque<int>	keys;
-	std::deque<int>	values;
+	while ((1UL << bits) < 2 * count)
+		++bits;
 
-	extractKeysAndValues(pairs, keys, values);
+	std::vector<int>	table(1UL << bits, -1);
+	const unsigned long	mask = (1UL << bits) - 1;
 
-	recursiveSort(keys);
-	mergeKeysAndValues(keys, values);
-
-	_deque = keys;
+	for (const int* it = first; it != last; ++it)
+	{
+		unsigned long	slot = (static_cast<unsigned int>(*it) * 2654435761u) >> (32 - (bits < 32 ? bits : 32));
 
-	if (_oddSequence)
-		_deque.pop_back();
+		while (table[slot & mask] != -1)
+		{
+			if (table[slot & mask] == *it)
+				return true;
+			++slot;
+		}
+		table[slot & mask] = *it;
+	}
+	return false;
 }
 
 /**
- * @brief Sorts the sequence stored in the vector using the merge-insert algorithm
+ * @brief Rejects a range of positive values holding the same value twice
+ * 
+ * Duplicates are looked up in a bitmap over [min, max] when it takes no more
+ * memory than the values themselves (32 bits per value), or in a flat hash
+ * set otherwise.
+ * 
+ * @throws std::runtime_error If a value appears twice
  */
-void	PmergeMe::sortSequenceWithVector()
+static void	checkDuplicates(const int* first, const int* last)
 {
-	std::vector<std::pair<int, int> >	pairs;
-
-	pairAndSort(pairs, _vector);
-
-	std::vector<int>	keys;
-	std::vector<int>	values;
+	if (first == last)
+		return;
 
-	extractKeysAndValues(pairs, keys, values);
+	int min = *first;
+	int max = *first;
 
-	recursiveSort(keys);
-	mergeKeysAndValues(keys, values);
+	for (const int* it = first; it != last; ++it)
+	{
+		if (*it < min)
+			min = *it;
+		if (*it > max)
+			max = *it;
+	}
 
-	_vector = keys;
+	unsigned long	range = static_cast<unsigned long>(max - min) + 1;
+	bool			duplicate;
 
-	if (_oddSequence == true)
-		_vector.pop_back();
+	if (range <= 32UL * static_cast<unsigned long>(last - first))
+		duplicate = hasDuplicateInBitmap(first, last, min, range);
+	else
+		duplicate = hasDuplicateInHashSet(first, last);
+	if (duplicate)
+		throw std::runtime_error("Error: Duplicate values are not allowed");
 }
 
 /**
- * @brief Pairs adjacent elements and sorts them by the first value in each pair
+ * @brief Adds a sequence of positive integers to the deque and vector containers
  * 
- * while the first element must always have the value pointed by the iterator,
- * the second element could not exist (last pair of an odd sequence). INT_MAX is
- * then used as a placeholder
+ * The sequence is validated before anything is stored (signs, then
+ * checkDuplicates). Both containers then receive the whole sequence at once,
+ * the vector with its capacity reserved.
  * 
- * @param pairs A container to store the pairs
- * @param container The original container of integers
+ * A single number is accepted here (it is already sorted): refusing it is a
+ * decision of the program, not of the sorter, and the benchmark starts at n = 1.
+ *
+ * @param sequence A sequence of positive integers
+ * @throws std::runtime_error If any integer in the sequence is negative or repeated
  */
-void	PmergeMe::pairAndSort(std::deque<std::pair<int, int> >& pairs, std::deque<int>& container)
+void PmergeMe::addSequence(const std::vector<int>& sequence)
 {
-	for (std::deque<int>::iterator it = container.begin(); it != container.end();)
-	{
-		int first = *it;
-		++it;
-		int second;
-
-		if (it != container.end())
-			second = *it;
-		else
-		{
-			second = INT_MAX;
-			_oddSequence = true;
-		}
-
-		if (first > second)
-			pairs.push_back(std::make_pair(second, first));
-		else
-			pairs.push_back(std::make_pair(first, second));
-
-		if (it != container.end())
-			++it;
-	}
-
-	std::sort(pairs.begin(), pairs.end());
-}
+	if (sequence.empty())
+		return;
 
-void PmergeMe::pairAndSort(std::vector<std::pair<int, int> >& pairs, std::vector<int>& container)
-{
-	for (std::vector<int>::iterator it = container.begin(); it != container.end();)
+	for (std::vector<int>::const_iterator it = sequence.begin(); it != sequence.end(); ++it)
 	{
-		int first = *it;
-		++it;
-		int second;
-
-		if (it != container.end())
-			second = *it;
-		else
-		{
-			second = INT_MAX;
-			_oddSequence = true;
-		}
-
-		if (first > second)
-			pairs.push_back(std::make_pair(second, first));
-		else
-			pairs.push_back(std::make_pair(first, second));
-
-		if (it != container.end())
-			++it;
+		if (*it < 0)
+			throw std::runtime_error("Error: Only positive integers are allowed");
 	}
-	std::sort(pairs.begin(), pairs.end());
+	checkDuplicates(&sequence[0], &sequence[0] + sequence.size());
+
+	_vector.reserve(_vector.size() + sequence.size());
+	_vector.insert(_vector.end(), sequence.begin(), sequence.end());
+	_deque.insert(_deque.end(), sequence.begin(), sequence.end());
 }
 
 /**
- * @brief Extracts keys and values from pairs into separate containers
+ * @brief Adds the whitespace-separated positive integers of a file ("-" for stdin)
+ * 
+ * Values are parsed straight into the vector (no token strings, no temporary
+ * container), checked for duplicates in place, then appended to the deque.
+ * On error the containers are left as they were.
  * 
- * @param pairs The sorted pairs of integers
- * @param keys A container to store the keys
- * @param values A container to store the values
+ * @param path Path of the file to read, or "-" for the standard input
+ * @throws std::runtime_error If the file cannot be read, or on an invalid or repeated value
  */
-void PmergeMe::extractKeysAndValues(const std::deque<std::pair<int, int> >& pairs, std::deque<int>& keys, std::deque<int>& values)
+void PmergeMe::addSequenceFromFile(const std::string& path)
 {
-	for (std::deque<std::pair<int, int> >::const_iterator it = pairs.begin(); it != pairs.end(); ++it)
+	std::FILE*	file = (path == "-") ? stdin : std::fopen(path.c_str(), "rb");
+
+	if (file == NULL)
+		throw std::runtime_error("Error: could not open file: " + path);
+
+	const std::size_t	start = _vector.size();
+
+	try
 	{
-		keys.push_back(it->first);
-		values.push_back(it->second);
-	}
-}
+		IntegerReader	reader(file);
+		int				value;
 
-void PmergeMe::extractKeysAndValues(const std::vector<std::pair<int, int> >& pairs, std::vector<int>& keys, std::vector<int>& values)
-{
-	for (std::vector<std::pair<int, int> >::const_iterator it = pairs.begin(); it != pairs.end(); ++it)
+		while (reader.next(value))
+			_vector.push_back(value);
+		if (_vector.size() > start)
+			checkDuplicates(&_vector[0] + start, &_vector[0] + _vector.size());
+	}
+	catch (...)
 	{
-		keys.push_back(it->first);
-		values.push_back(it->second);
+		_vector.resize(start);
+		if (file != stdin)
+			std::fclose(file);
+		throw;
 	}
+	if (file != stdin)
+		std::fclose(file);
+	_deque.insert(_deque.end(), _vector.begin() + start, _vector.end());
 }
 
 /**
- * @brief Recursively sorts the keys using the merge-insert technique
- * 
- * @param keys The keys to be recursively sorted
+ * @brief Sorts the sequence stored in the deque using the merge-insert algorithm
  */
-void PmergeMe::recursiveSort(std::deque<int>& keys)
+void	PmergeMe::sortSequenceWithDeque()
 {
-	if (keys.size() <= 1)
-		return;
-
-	std::deque<int>::iterator	middle = keys.begin() + keys.size() / 2;
-	std::deque<int>				left(keys.begin(), middle);
-	std::deque<int>				right(middle, keys.end());
+	MergeInsertion<std::deque<int> >	engine;
 
-	recursiveSort(left);
-	recursiveSort(right);
-
-	keys.clear();
-	std::merge(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(keys));
+	engine.setThreads(_threads);
+	engine.sort(_deque);
+	_stats = engine.getStats();
 }
 
-void PmergeMe::recursiveSort(std::vector<int>& keys)
+/**
+ * @brief Sorts the sequence stored in the vector using the merge-insert algorithm
+ */
+void	PmergeMe::sortSequenceWithVector()
 {
-	if (keys.size() <= 1)
-		return;
+	MergeInsertion<std::vector<int> >	engine;
 
-	std::vector<int>::iterator	middle = keys.begin() + keys.size() / 2;
-	std::vector<int>			left(keys.begin(), middle);
-	std::vector<int>			right(middle, keys.end());
-
-	recursiveSort(left);
-	recursiveSort(right);
-
-	keys.clear();
-	std::merge(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(keys));
+	engine.setThreads(_threads);
+	engine.sort(_vector);
+	_stats = engine.getStats();
 }
 
 /**
- * @brief Merges the sorted keys and values
+ * @brief Writes one line "<label> <sequence>" in the given display mode
+ * 
+ * The same pass sums the elements (the checksum) and checks that they are in
+ * non-decreasing order, whatever is printed.
  * 
- * @param keys The sorted keys
- * @param values The sorted values
+ * @return true If the sequence is sorted
  */
-void PmergeMe::mergeKeysAndValues(std::deque<int>& keys, const std::deque<int>& values)
+template <typename Container>
+static bool	writeSequence(OutputBuffer& out, const char* label, const Container& sequence,
+				PmergeMe::DisplayMode mode, std::size_t prefix)
 {
-	for (std::deque<int>::const_iterator it = values.begin(); it != values.end(); ++it)
+	unsigned long long	checksum = 0;
+	bool				sorted = true;
+	std::size_t			index = 0;
+	int					previous = 0;
+
+	out.write(label);
+	for (typename Container::const_iterator it = sequence.begin(); it != sequence.end(); ++it, ++index)
 	{
-		std::deque<int>::iterator pos = std::lower_bound(keys.begin(), keys.end(), *it);
-		keys.insert(pos, *it);
+		if (index > 0 && *it < previous)
+			sorted = false;
+		previous = *it;
+		checksum += static_cast<unsigned long long>(*it);
+		if (mode == PmergeMe::DISPLAY_ALL || (mode == PmergeMe::DISPLAY_PREFIX && index < prefix))
+		{
+			out.write(*it);
+			out.write(' ');
+		}
 	}
-}
-
-void PmergeMe::mergeKeysAndValues(std::vector<int>& keys, const std::vector<int>& values)
-{
-	for (std::vector<int>::const_iterator it = values.begin(); it != values.end(); ++it)
+	if (mode == PmergeMe::DISPLAY_PREFIX && sequence.size() > prefix)
+		out.write("[...]");
+	else if (mode == PmergeMe::DISPLAY_CHECKSUM)
 	{
-		std::vector<int>::iterator pos = std::lower_bound(keys.begin(), keys.end(), *it);
-		keys.insert(pos, *it);
+		out.write(static_cast<unsigned long long>(sequence.size()));
+		out.write(" elements, checksum ");
+		out.write(checksum);
 	}
+	out.write('\n');
+	return sorted;
 }
 
 /**
- * @brief Displays the contents of the sorted sequence with a given container type
+ * @brief Sorts one container and displays it before and after, with the time taken
+ * 
+ * The sequences go through an OutputBuffer in the display mode chosen with
+ * setDisplay, so a large run is not dominated by printing.
  * 
  * @param containerType A string indicating the type of container ("Deque" or "Vector")
+ * @return false If the container is not sorted afterwards (an error is printed)
  */
-void PmergeMe::sortAndDisplaySequence(const std::string& containerType) const
+bool PmergeMe::sortAndDisplaySequence(const std::string& containerType) const
 {
+	OutputBuffer	out(stdout);
+	bool			sorted;
+	double			time;
+	std::size_t		size;
+	const char*		name;
+
 	if (containerType == "Deque")
 	{
-		std::cout << "Before: ";
-		for (std::deque<int>::const_iterator it = _deque.begin(); it != _deque.end(); ++it)
-			std::cout << *it << " ";
-		std::cout << std::endl;
-
-		double timeDeque = measureTime(&PmergeMe::sortSequenceWithDeque);
-		
-		std::cout << "After: ";
-		for (std::deque<int>::const_iterator it = _deque.begin(); it != _deque.end(); ++it)
-			std::cout << *it << " ";
-		std::cout << std::endl;
-
-		std::cout << std::fixed << std::showpoint << std::setprecision(5);
-		std::cout << "Time to process a range of " << _deque.size() << " elements with std::deque: ";
-		std::cout << timeDeque / 100 << " us" << std::endl;
+		writeSequence(out, "Before: ", _deque, _display, _prefix);
+		out.flush();
+		time = measureTime(&PmergeMe::sortSequenceWithDeque);
+		sorted = writeSequence(out, "After: ", _deque, _display, _prefix);
+		size = _deque.size();
+		name = "std::deque";
 	}
 	else if (containerType == "Vector")
 	{
-		std::cout << "Before: ";
-		for (std::vector<int>::const_iterator it = _vector.begin(); it != _vector.end(); ++it)
-			std::cout << *it << " ";
-		std::cout << std::endl;
-
-		double timeVector = measureTime(&PmergeMe::sortSequenceWithVector);
-		
-		std::cout << "After: ";
-		for (std::vector<int>::const_iterator it = _vector.begin(); it != _vector.end(); ++it)
-			std::cout << *it << " ";
-		std::cout << std::endl;
-
-		std::cout << std::fixed << std::showpoint << std::setprecision(5);
-		std::cout << "Time to process a range of " << _vector.size() << " elements with std::vector: ";
-		std::cout << timeVector / 100 << " us" << std::endl;
+		writeSequence(out, "Before: ", _vector, _display, _prefix);
+		out.flush();
+		time = measureTime(&PmergeMe::sortSequenceWithVector);
+		sorted = writeSequence(out, "After: ", _vector, _display, _prefix);
+		size = _vector.size();
+		name = "std::vector";
 	}
+	else
+		return false;
+	out.flush();
+
+	std::cout << std::fixed << std::showpoint << std::setprecision(5);
+	std::cout << "Time to process a range of " << size << " elements with " << name << ": ";
+	std::cout << time << " us" << std::endl;
+	if (!sorted)
+		std::cerr << "Error: the " << name << " sequence is not sorted" << std::endl;
+	return sorted;
 }
 
-#include <sys/time.h>
 /**
  * @brief Measures and displays the time taken to sort the container
  * 
+ * Uses a monotonic clock, the returned value is already in microseconds.
+ * 
  * @param sortMethod The sorting method to call on the container
- * @param container The container to be sorted
  * @return double The time taken to sort the container in microseconds
  */
 double	PmergeMe::measureTime(void (PmergeMe::*sortMethod)()) const
 {
-	clock_t start, end;
+	double start = monotonicMicroseconds();
 
-	start = clock();
-	
 	(const_cast<PmergeMe*>(this)->*sortMethod)();
-	
-	end = clock();
 
-	return (double)(end - start) / CLOCKS_PER_SEC * 1000000;
+	return monotonicMicroseconds() - start;
+}
+
+/* parallel mode */
+void	PmergeMe::setThreads(std::size_t threads)
+{
+	_threads = threads;
+}
+
+/* display mode */
+void	PmergeMe::setDisplay(DisplayMode mode, std::size_t prefix)
+{
+	_display = mode;
+	_prefix = prefix;
+}
+
+/* instrumentation */
+const SortStats&	PmergeMe::getStats() const
+{
+	return _stats;
+}
+
+const std::deque<int>&	PmergeMe::getDeque() const
+{
+	return _deque;
+}
+
+const std::vector<int>&	PmergeMe::getVector() const
+{
+	return _vector;
 }
 
 /* utility */
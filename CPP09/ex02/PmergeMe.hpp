@@ -5,19 +5,40 @@
 #include <deque>
 #include <utility>
 #include <string>
+#include "Instrumentation.hpp"
+#include "MergeInsertion.hpp"
 
 class PmergeMe
 {
 public:
+	/* What sortAndDisplaySequence prints of the Before/After sequences */
+	enum DisplayMode
+	{
+		DISPLAY_ALL,		// every element
+		DISPLAY_PREFIX,		// the first `prefix` elements, then [...]
+		DISPLAY_CHECKSUM	// the element count and the sum of the elements
+	};
+
 	PmergeMe();
 	PmergeMe( const PmergeMe& other );
 	PmergeMe& operator=( const PmergeMe& other );
 	~PmergeMe();
 
 	void	addSequence(const std::vector<int>& sequence);
+	void	addSequenceFromFile(const std::string& path);
 	void	sortSequenceWithDeque();
 	void	sortSequenceWithVector();
-	void	sortAndDisplaySequence(const std::string& containerType) const;
+	bool	sortAndDisplaySequence(const std::string& containerType) const;
+
+	/* parallel mode: 0 (default) keeps the sequential sort */
+	void	setThreads(std::size_t threads);
+	/* display mode: DISPLAY_ALL (default), a prefix of `prefix` elements, or a checksum */
+	void	setDisplay(DisplayMode mode, std::size_t prefix = 0);
+
+	/* instrumentation */
+	const SortStats&			getStats() const;
+	const std::deque<int>&		getDeque() const;
+	const std::vector<int>&		getVector() const;
 
 	/* utility */
 	void	printRawSequence();
@@ -27,19 +48,13 @@ private:
 	std::deque<int>		_deque;
 	std::vector<int>	_vector;
 
-	bool	_oddSequence;
+	/* counters and stage timings of the last sort */
+	SortStats	_stats;
 
-	/* deque container */
-	void	pairAndSort(std::deque<std::pair<int, int> >& pairs, std::deque<int>& container);
-	void	extractKeysAndValues(const std::deque<std::pair<int, int> >& pairs, std::deque<int>& keys, std::deque<int>& values);
-	void	recursiveSort(std::deque<int>& keys);
-	void	mergeKeysAndValues(std::deque<int>& keys, const std::deque<int>& values);
+	std::size_t	_threads;
 
-	/* vector container */
-	void	pairAndSort(std::vector<std::pair<int, int> >& pairs, std::vector<int>& container);
-	void	extractKeysAndValues(const std::vector<std::pair<int, int> >& pairs, std::vector<int>& keys, std::vector<int>& values);
-	void	recursiveSort(std::vector<int>& keys);
-	void	mergeKeysAndValues(std::vector<int>& keys, const std::vector<int>& values);
+	DisplayMode	_display;
+	std::size_t	_prefix;
 
 	double	measureTime(void (PmergeMe::*sortMethod)()) const;
 };
@@ -1,4 +1,6 @@
 #include "PmergeMe.hpp"
+#include "Benchmark.hpp"
+#include "ExternalSort.hpp"
 #include <iostream>
 #include <vector>
 #include <cstdlib>
@@ -6,6 +8,134 @@
 #include <sstream>
 #include <string>
 #include <limits.h>
+#include <cstdio>
+#include <iomanip>
+#include <unistd.h>
+
+/* Runs both sorts once the sequence is loaded */
+static int	sortAndDisplay(PmergeMe& pmergeMe, size_t size)
+{
+	// Check if we got any numbers after parsing
+	if (size == 0)
+	{
+		std::cerr << "Error: No valid numbers provided" << std::endl;
+		return 1;
+	}
+	if (size == 1)
+	{
+		std::cerr << "Error: cannot sort a single number" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Testing with std::deque:" << std::endl;
+	bool sorted = pmergeMe.sortAndDisplaySequence("Deque");
+
+	std::cout << "\nTesting with std::vector:" << std::endl;
+	sorted = pmergeMe.sortAndDisplaySequence("Vector") && sorted;
+
+	return sorted ? 0 : 1;
+}
+
+/*
+ * Opens a temporary file next to path (same directory, so rename() is atomic)
+ * and stores its name in tempPath; NULL if it cannot be created
+ */
+static std::FILE*	openBeside(const std::string& path, std::string& tempPath)
+{
+	std::vector<char>	name(path.begin(), path.end());
+	const char			suffix[] = ".XXXXXX";
+
+	name.insert(name.end(), suffix, suffix + sizeof(suffix));
+	int	fd = mkstemp(&name[0]);
+	if (fd < 0)
+		return NULL;
+	tempPath = &name[0];
+	std::FILE*	file = fdopen(fd, "wb");
+	if (file == NULL)
+	{
+		close(fd);
+		std::remove(tempPath.c_str());
+	}
+	return file;
+}
+
+/*
+ * ./PmergeMe --external <input|-> <output|-> [run size]: sorts a file larger than memory.
+ * The values go to a temporary file renamed to the output once the sort succeeded, so a
+ * failure (a duplicate found in the last merge) leaves no partial output behind.
+ */
+static int	runExternalSort(int argc, char* argv[])
+{
+	if (argc < 4 || argc > 5)
+	{
+		std::cerr << "Error: --external expects <input|-> <output|-> [run size]" << std::endl;
+		return 1;
+	}
+
+	long runSize = ExternalSort::DEFAULT_RUN_SIZE;
+	if (argc == 5)
+	{
+		char* endptr;
+		runSize = std::strtol(argv[4], &endptr, 10);
+		if (*endptr != '\0' || runSize < 2)
+		{
+			std::cerr << "Error: invalid run size: " << argv[4] << std::endl;
+			return 1;
+		}
+	}
+
+	std::string	inputPath(argv[2]);
+	std::string	outputPath(argv[3]);
+	std::FILE*	input = (inputPath == "-") ? stdin : std::fopen(inputPath.c_str(), "rb");
+	if (input == NULL)
+	{
+		std::cerr << "Error: could not open file: " << inputPath << std::endl;
+		return 1;
+	}
+	std::string	tempPath;
+	std::FILE*	output = (outputPath == "-") ? stdout : openBeside(outputPath, tempPath);
+	if (output == NULL)
+	{
+		std::cerr << "Error: could not open file: " << outputPath << std::endl;
+		if (input != stdin)
+			std::fclose(input);
+		return 1;
+	}
+
+	ExternalSort	sorter(static_cast<size_t>(runSize));
+	int				status = 0;
+	double			start = monotonicMicroseconds();
+	try
+	{
+		size_t count = sorter.sort(input, output);
+		// the summary goes to stderr, stdout may be carrying the sorted values
+		std::cerr << "Sorted " << count << " elements in " << sorter.getRuns() << " runs, "
+			<< sorter.getMergePasses() << " merge passes: " << std::fixed << std::setprecision(5)
+			<< monotonicMicroseconds() - start << " us" << std::endl;
+	}
+	catch (const std::runtime_error& e)
+	{
+		std::cerr << e.what() << std::endl;
+		status = 1;
+	}
+	if (input != stdin)
+		std::fclose(input);
+	if (output == stdout)
+		return status;
+	if (std::fclose(output) != 0 && status == 0)
+	{
+		std::cerr << "Error: could not write file: " << outputPath << std::endl;
+		status = 1;
+	}
+	if (status == 0 && std::rename(tempPath.c_str(), outputPath.c_str()) != 0)
+	{
+		std::cerr << "Error: could not write file: " << outputPath << std::endl;
+		status = 1;
+	}
+	if (status != 0)
+		std::remove(tempPath.c_str());
+	return status;
+}
 
 int main(int argc, char* argv[])
 {
@@ -15,10 +145,124 @@ int main(int argc, char* argv[])
 		return 1;
 	}
 
+	// Instrumented mode: ./PmergeMe --bench [maxN] writes a CSV sweep on stdout
+	if (std::string(argv[1]) == "--bench")
+	{
+		long maxN = 100000;
+		if (argc > 2)
+		{
+			char* endptr;
+			maxN = std::strtol(argv[2], &endptr, 10);
+			if (*endptr != '\0' || maxN <= 0)
+			{
+				std::cerr << "Error: invalid benchmark size: " << argv[2] << std::endl;
+				return 1;
+			}
+		}
+		return runBenchmark(static_cast<size_t>(maxN), std::cout);
+	}
+
+	// Generic engine checks on 64-bit keys and key/payload records
+	if (std::string(argv[1]) == "--check")
+		return runEngineChecks(std::cout);
+
+	// Parallel sweep: ./PmergeMe --parallel [n] writes time and speedup per thread count
+	if (std::string(argv[1]) == "--parallel")
+	{
+		long n = 100000;
+		if (argc > 2)
+		{
+			char* endptr;
+			n = std::strtol(argv[2], &endptr, 10);
+			if (*endptr != '\0' || n <= 0)
+			{
+				std::cerr << "Error: invalid benchmark size: " << argv[2] << std::endl;
+				return 1;
+			}
+		}
+		return runParallelBenchmark(static_cast<size_t>(n), std::cout);
+	}
+
+	// Small-n kernel against the pure recursion: ./PmergeMe --kernel [n]
+	if (std::string(argv[1]) == "--kernel")
+	{
+		long n = 100000;
+		if (argc > 2)
+		{
+			char* endptr;
+			n = std::strtol(argv[2], &endptr, 10);
+			if (*endptr != '\0' || n <= 0)
+			{
+				std::cerr << "Error: invalid benchmark size: " << argv[2] << std::endl;
+				return 1;
+			}
+		}
+		return runKernelBenchmark(static_cast<size_t>(n), std::cout);
+	}
+
+	if (std::string(argv[1]) == "--external")
+		return runExternalSort(argc, argv);
+
 	PmergeMe pmergeMe;
 	std::vector<int> sequence;
+	int first = 1;
+
+	// Options before the sequence:
+	//   --threads N   sorts large levels on N threads
+	//   --prefix N    prints only the first N elements of each sequence
+	//   --checksum    prints only the element count and checksum of each sequence
+	while (first < argc && std::string(argv[first]).compare(0, 2, "--") == 0
+		&& std::string(argv[first]) != "--input")
+	{
+		std::string option(argv[first]);
+
+		if (option == "--checksum")
+		{
+			pmergeMe.setDisplay(PmergeMe::DISPLAY_CHECKSUM);
+			first += 1;
+			continue;
+		}
+		if (option != "--threads" && option != "--prefix")
+		{
+			std::cerr << "Error: unknown option: " << option << std::endl;
+			return 1;
+		}
+
+		char* endptr;
+		long value = (first + 1 < argc) ? std::strtol(argv[first + 1], &endptr, 10) : -1;
+		if (first + 1 >= argc || *endptr != '\0' || value < 0)
+		{
+			std::cerr << "Error: " << option << " expects a count" << std::endl;
+			return 1;
+		}
+		if (option == "--threads")
+			pmergeMe.setThreads(static_cast<size_t>(value));
+		else
+			pmergeMe.setDisplay(PmergeMe::DISPLAY_PREFIX, static_cast<size_t>(value));
+		first += 2;
+	}
 
-	for (int i = 1; i < argc; ++i)
+	// ./PmergeMe --input <file|-> reads the sequence from a file or stdin
+	if (first < argc && std::string(argv[first]) == "--input")
+	{
+		if (first + 2 != argc)
+		{
+			std::cerr << "Error: --input expects one file name (or - for stdin)" << std::endl;
+			return 1;
+		}
+		try
+		{
+			pmergeMe.addSequenceFromFile(argv[first + 1]);
+		}
+		catch (const std::runtime_error& e)
+		{
+			std::cerr << e.what() << std::endl;
+			return 1;
+		}
+		return sortAndDisplay(pmergeMe, pmergeMe.getVector().size());
+	}
+
+	for (int i = first; i < argc; ++i)
 	{
 		std::string arg(argv[i]);
 		std::istringstream iss(arg);
@@ -66,13 +310,6 @@ int main(int argc, char* argv[])
 		}
 	}
 
-	// Check if we got any numbers after parsing
-	if (sequence.empty())
-	{
-		std::cerr << "Error: No valid numbers provided" << std::endl;
-		return 1;
-	}
-
 	try
 	{
 		pmergeMe.addSequence(sequence);
@@ -82,12 +319,5 @@ int main(int argc, char* argv[])
 		std::cerr << e.what() << std::endl;
 		return 1;
 	}
-
-	std::cout << "Testing with std::deque:" << std::endl;
-	pmergeMe.sortAndDisplaySequence("Deque");
-
-	std::cout << "\nTesting with std::vector:" << std::endl;
-	pmergeMe.sortAndDisplaySequence("Vector");
-
-	return 0;
-}
\ No newline at end of file
+	return sortAndDisplay(pmergeMe, sequence.size());
+}
@@ -88,6 +88,8 @@ run_test "Basic sorting" "5 3 7 1 8 6 2 4" "After: 1 2 3 4 5 6 7 8"
 run_test "Already sorted" "1 2 3 4 5" "After: 1 2 3 4 5"
 run_test "Reverse sorted" "5 4 3 2 1" "After: 1 2 3 4 5"
 run_test "Duplicate numbers" "5 3 3 7" "Error" "true"
+run_test "Duplicate sparse numbers" "7 1000000 2000000000 3 1000000" "Error" "true"
+run_test "Sparse numbers" "7 1000000 2000000000 3 999999" "After: 3 7 999999 1000000 2000000000"
 run_test "Single number" "42" "Error" "true"
 
 # Error handling tests
@@ -96,6 +98,68 @@ run_test "Non-numeric input" "5 3 abc 1 8" "Error" "true"
 run_test "Very large number" "5 3 2147483648 1 8" "Error" "true"
 run_test "Empty input" "" "Error" "true"
 
+# Instrumented mode
+run_test "Benchmark CSV header" "--bench 20" "n,container,comparisons,lower_bound,ford_johnson"
+run_test "Benchmark rows are sorted" "--bench 20" "20,vector,"
+run_test "Benchmark invalid size" "--bench abc" "Error" "true"
+run_test "Benchmark chunked container" "--bench 50" "50,chunked,"
+run_test "Generic engine element types" "--check" "OK   ChunkedVector<Record> by key"
+run_test "Small-n kernel sweep" "--kernel 1000" "16,1000,200,"
+run_test "Small-n kernel permutations" "--check" "OK   every permutation of 8, small-n kernel"
+run_test "Parallel sweep" "--parallel 50000" "parallel,2,"
+run_test "Parallel sort" "--threads 4 5 3 7 1 8 6 2 4" "After: 1 2 3 4 5 6 7 8"
+run_test "Prefix display" "--prefix 3 5 3 7 1 8 6 2 4" "After: 1 2 3 [...]"
+run_test "Checksum display" "--checksum 5 3 7 1 8 6 2 4" "After: 8 elements, checksum 36"
+run_test "Invalid prefix" "--prefix x 5 3 7" "Error" "true"
+run_test "Unknown option" "--fast 5 3 7" "Error" "true"
+
+# File input
+input_file=$(mktemp)
+printf "5 3\n7 1\t8 6 2 4\n" > "$input_file"
+run_test "Input file" "--input $input_file" "After: 1 2 3 4 5 6 7 8"
+printf "5 3 x 1\n" > "$input_file"
+run_test "Input file with invalid value" "--input $input_file" "Error" "true"
+printf "5 3 5 1\n" > "$input_file"
+run_test "Input file with duplicate" "--input $input_file" "Error" "true"
+seq 1 5000 | sort -R > "$input_file"
+run_test "External sort" "--external $input_file - 1000" "Sorted 5000 elements in 5 runs, 1 merge passes"
+run_test "External sort, several merge passes" "--external $input_file - 20" "Sorted 5000 elements in 250 runs, 2 merge passes"
+printf "4 1 2 7 3 4\n" > "$input_file"
+run_test "External sort with duplicate across runs" "--external $input_file - 2" "Error" "true"
+
+# A duplicate found in the last merge must not leave a partial output file
+((TOTAL++))
+echo -e "${YELLOW}Test $TOTAL: External sort failure leaves no output file${NC}"
+output_file="$input_file.sorted"
+rm -f "$output_file"
+(seq 1 30; echo 5; seq 31 60) > "$input_file"
+./PmergeMe --external "$input_file" "$output_file" 10 > /dev/null 2>&1
+exit_code=$?
+if [ $exit_code -ne 0 ] && [ ! -e "$output_file" ] && [ -z "$(ls "$output_file".* 2>/dev/null)" ]; then
+    echo -e "${GREEN}✓ Test passed! Failed with status $exit_code and no output file${NC}"
+    ((PASSED++))
+else
+    echo -e "${RED}✘ Test failed! Status $exit_code, output file: $(ls "$output_file"* 2>/dev/null)${NC}"
+    ((FAILED++))
+fi
+echo "-----------------------"
+rm -f "$output_file" "$output_file".*
+seq 1 100 | sort -R > "$input_file"
+./PmergeMe --external "$input_file" "$output_file" 10 > /dev/null 2>&1
+((TOTAL++))
+echo -e "${YELLOW}Test $TOTAL: External sort writes the output file${NC}"
+if [ -f "$output_file" ] && [ "$(tr '\n' ' ' < "$output_file")" = "$(seq 1 100 | tr '\n' ' ')" ]; then
+    echo -e "${GREEN}✓ Test passed!${NC}"
+    ((PASSED++))
+else
+    echo -e "${RED}✘ Test failed! The output file is missing or not sorted${NC}"
+    ((FAILED++))
+fi
+echo "-----------------------"
+rm -f "$output_file" "$output_file".*
+rm -f "$input_file"
+run_test "Missing input file" "--input /nonexistent/pmergeme" "Error" "true"
+
 # Performance tests with different sizes
 echo -e "${BLUE}Running performance tests with different sequence sizes...${NC}"
 